@@ -0,0 +1,84 @@
+#include <cipher/affine.hpp>
+#include <math/num.hpp>
+#include <math/static.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace kimp::math;
+
+constexpr std::size_t BufferSize = 1 << 20;
+
+auto randomBytes() -> std::vector<std::byte> {
+    std::mt19937_64 rng {BufferSize};
+    std::vector<std::byte> bytes (BufferSize);
+    for (auto& b : bytes) {
+        b = static_cast<std::byte>(rng());
+    }
+    return bytes;
+}
+
+// Throughput in bytes per second of every kernel this CPU supports
+auto BM_AffineByteCipher(benchmark::State& state) -> void {
+    auto kernel = static_cast<kimp::cipher::EAffineKernel>(state.range(0));
+    if (!kimp::cipher::isAffineKernelSupported(kernel)) {
+        state.SkipWithError("Kernel is not supported by this CPU");
+        return;
+    }
+    kimp::cipher::TAffineByteCipher cipher {std::byte {0x57}, std::byte {0x13}, kernel};
+    bool encoding = state.range(1) != 0;
+
+    auto in = randomBytes();
+    std::vector<std::byte> out (in.size());
+    for (auto _ : state) {
+        encoding ? cipher.Encode(in, out) : cipher.Decode(in, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(in.size()));
+}
+BENCHMARK(BM_AffineByteCipher)
+    ->ArgNames({"kernel", "encode"})
+    ->ArgsProduct({
+        {
+            static_cast<i64>(kimp::cipher::EAffineKernel::Scalar)
+            , static_cast<i64>(kimp::cipher::EAffineKernel::Ssse3)
+            , static_cast<i64>(kimp::cipher::EAffineKernel::Avx2)
+            , static_cast<i64>(kimp::cipher::EAffineKernel::Avx512)
+        }
+        , {1, 0}
+    });
+
+// Symbol by symbol alphabet cipher over GF(3^3), the way the value mode does it
+auto BM_AlphabetCipher(benchmark::State& state) -> void {
+    using TCipherField = GF<3, 3, 1, 0, 2, 1>;
+    bool encoding = state.range(0) != 0;
+
+    std::mt19937_64 rng {BufferSize};
+    std::vector<TCipherField::TElement> in (BufferSize);
+    for (auto& e : in) {
+        e = TCipherField::TElement {rng() % TCipherField::Q};
+    }
+    std::vector<ui8> out (in.size());
+
+    auto a = TCipherField::TElement {5}, b = TCipherField::TElement {11};
+    auto reversed = TCipherField::Inverse(a);
+    for (auto _ : state) {
+        for (std::size_t i {0}; i < in.size(); i++) {
+            auto to = encoding ? a * in[i] + b : (in[i] - b) * reversed;
+            out[i] = static_cast<ui8>(to.Rank());
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(in.size()));
+}
+BENCHMARK(BM_AlphabetCipher)->ArgName("encode")->Arg(1)->Arg(0);
+
+} // namespace
@@ -0,0 +1,76 @@
+#include "fields.hpp"
+
+#include <math/cyclic.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace kimp::bench;
+
+auto BM_FieldConstruction(benchmark::State& state) -> void {
+    auto p = static_cast<ui64>(state.range(0)), n = static_cast<ui64>(state.range(1));
+    auto base = firstIrreducible(p, n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::make_shared<TGaluaField>(base, p, n));
+    }
+}
+BENCHMARK(BM_FieldConstruction)->Apply(fieldArguments)->Unit(benchmark::kMicrosecond);
+
+// Random operand pairs cycled through, so the loop measures Apply rather than
+// the branch predictor learning one pair
+template <typename TGetOperation>
+auto applyOperation(benchmark::State& state, TGetOperation getOperation) -> void {
+    constexpr std::size_t Pairs = 1024;
+
+    auto field = makeField(state);
+    auto operation = getOperation(*field);
+
+    std::mt19937_64 rng {static_cast<ui64>(state.range(0) * 31 + state.range(1))};
+    std::vector<std::pair<TPolynomial<i64>, TPolynomial<i64>>> operands;
+    for (std::size_t i {0}; i < Pairs; i++) {
+        operands.emplace_back(field->At(rng() % field->Size()), field->At(rng() % field->Size()));
+    }
+
+    std::size_t i {0};
+    for (auto _ : state) {
+        const auto& [a, b] = operands[i++ % Pairs];
+        benchmark::DoNotOptimize(operation->Apply(a, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+auto BM_SumApply(benchmark::State& state) -> void {
+    applyOperation(state, [] (const TGaluaField& f) { return f.GetSumOperation(); });
+}
+BENCHMARK(BM_SumApply)->Apply(fieldArguments);
+
+auto BM_MulApply(benchmark::State& state) -> void {
+    applyOperation(state, [] (const TGaluaField& f) { return f.GetMulOperation(); });
+}
+BENCHMARK(BM_MulApply)->Apply(fieldArguments);
+
+// The work of TCryptoApp::ExploreMultiplicativeGroup without printing: the
+// subgroup lattice and every subgroup's generators sorted by rank
+auto BM_ExploreMultiplicativeGroup(benchmark::State& state) -> void {
+    auto field = makeField(state);
+    for (auto _ : state) {
+        for (const auto& subgroup : field->Subgroups()) {
+            std::vector<ui64> ranks;
+            for (const auto& e : subgroup.GetGenerators()) {
+                ranks.push_back(field->IndexOf(e));
+            }
+            std::sort(ranks.begin(), ranks.end());
+            benchmark::DoNotOptimize(ranks.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(field->Size() - 1));
+}
+BENCHMARK(BM_ExploreMultiplicativeGroup)->Apply(fieldArguments)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <math/field.hpp>
+#include <math/irreducible.hpp>
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+#include <math/rank.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <stdexcept>
+
+namespace kimp::bench {
+
+using namespace kimp::math;
+
+// (p, n) of the fields every field benchmark runs over
+inline auto fieldArguments(benchmark::internal::Benchmark* b) -> void {
+    b->ArgNames({"p", "n"});
+    for (auto [p, n] : {std::pair {2, 8}, {2, 16}, {3, 5}, {3, 7}, {5, 4}, {7, 3}, {251, 2}}) {
+        b->Args({p, n});
+    }
+}
+
+// The monic irreducible polynomial of degree n with the smallest rank
+inline auto firstIrreducible(ui64 p, ui64 n) -> TPolynomialPtr<i64> {
+    ui64 q {1};
+    for (ui64 i {0}; i < n; i++) {
+        q *= p;
+    }
+    for (ui64 rank {q}; rank < 2 * q; rank++) {
+        if (auto candidate = rankToPolynomial<i64>(rank, p); isIrreducible(candidate, p)) {
+            return std::make_shared<TPolynomial<i64>>(candidate);
+        }
+    }
+    throw std::logic_error("There is no irreducible polynomial of the given degree");
+}
+
+inline auto makeField(const benchmark::State& state) -> TGaluaFieldPtr {
+    auto p = static_cast<ui64>(state.range(0)), n = static_cast<ui64>(state.range(1));
+    return std::make_shared<TGaluaField>(firstIrreducible(p, n), p, n);
+}
+
+} // namespace kimp::bench
@@ -0,0 +1,74 @@
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace kimp::math;
+
+auto randomPolynomial(std::size_t degree, std::mt19937_64& rng) -> TPolynomial<i64> {
+    std::vector<i64> coefficients (degree + 1);
+    for (auto& c : coefficients) {
+        c = static_cast<i64>(rng() % 251);
+    }
+    coefficients[0] = 1;
+    return TPolynomial<i64> {coefficients};
+}
+
+auto BM_PolynomialMul(benchmark::State& state) -> void {
+    std::mt19937_64 rng {static_cast<ui64>(state.range(0))};
+    auto a = randomPolynomial(static_cast<std::size_t>(state.range(0)), rng);
+    auto b = randomPolynomial(static_cast<std::size_t>(state.range(0)), rng);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+    state.SetComplexityN(state.range(0));
+}
+// Reaches past the default NTT threshold, so both the Karatsuba and the NTT
+// paths are timed. The fit is dominated by the NTT end
+BENCHMARK(BM_PolynomialMul)->ArgName("degree")->RangeMultiplier(4)->Range(16, 1 << 16)->Complexity(benchmark::oNLogN);
+
+// Karatsuba against NTT on the same operands around the NTT threshold, the
+// crossover is where polynomialMulThresholds.Ntt belongs on this machine
+auto BM_PolynomialMulCrossover(benchmark::State& state) -> void {
+    auto degree = static_cast<std::size_t>(state.range(0));
+    std::mt19937_64 rng {degree};
+    auto a = randomPolynomial(degree, rng);
+    auto b = randomPolynomial(degree, rng);
+
+    auto saved = polynomialMulThresholds;
+    polynomialMulThresholds.Ntt = state.range(1) ? 0 : ~std::size_t {0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+    polynomialMulThresholds = saved;
+    state.SetLabel(state.range(1) ? "ntt" : "karatsuba");
+}
+BENCHMARK(BM_PolynomialMulCrossover)->ArgNames({"degree", "ntt"})->ArgsProduct({
+    benchmark::CreateRange(1 << 12, 1 << 17, 2)
+    , {0, 1}
+});
+
+// Dividend of twice the degree by x^d + 1: integer long division keeps the
+// coefficients bounded, any other divisor lets them overflow
+auto BM_PolynomialMod(benchmark::State& state) -> void {
+    auto degree = static_cast<std::size_t>(state.range(0));
+    std::mt19937_64 rng {degree};
+    auto a = randomPolynomial(2 * degree, rng);
+
+    std::vector<i64> coefficients (degree + 1, 0);
+    coefficients.front() = coefficients.back() = 1;
+    TPolynomial<i64> b {coefficients};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a % b);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolynomialMod)->ArgName("degree")->RangeMultiplier(4)->Range(16, 1 << 12)->Complexity();
+
+} // namespace
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <math/binary.hpp>
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KIMP_HAS_X86_SHUFFLE
+#endif
+
+namespace kimp::cipher {
+
+using namespace kimp::math;
+
+// y = a * x + b over GF(2^8) split by nibbles: a * x = a * (x & 0xF) + a * (x & 0xF0),
+// so two 16-entry tables are enough and fit into one pshufb register each
+struct TAffineNibbleTables {
+    alignas(16) std::array<ui8, 16> Low;
+    alignas(16) std::array<ui8, 16> High;
+    ui8 Shift;
+};
+
+using TAffineKernel = void (*)(const TAffineNibbleTables&, const std::byte*, std::byte*, std::size_t);
+
+inline auto affineScalar(const TAffineNibbleTables& t, const std::byte* in, std::byte* out, std::size_t size) -> void {
+    if (size < 256) {
+        for (std::size_t i {0}; i < size; i++) {
+            auto x = static_cast<ui8>(in[i]);
+            out[i] = static_cast<std::byte>(t.Low[x & 0xF] ^ t.High[x >> 4] ^ t.Shift);
+        }
+        return;
+    }
+
+    std::array<ui8, 256> full;
+    for (std::size_t x {0}; x < 256; x++) {
+        full[x] = t.Low[x & 0xF] ^ t.High[x >> 4] ^ t.Shift;
+    }
+    for (std::size_t i {0}; i < size; i++) {
+        out[i] = static_cast<std::byte>(full[static_cast<ui8>(in[i])]);
+    }
+}
+
+#ifdef KIMP_HAS_X86_SHUFFLE
+__attribute__((target("ssse3")))
+inline auto affineSsse3(const TAffineNibbleTables& t, const std::byte* in, std::byte* out, std::size_t size) -> void {
+    const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(t.Low.data()));
+    const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i*>(t.High.data()));
+    const __m128i shift = _mm_set1_epi8(static_cast<char>(t.Shift));
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    std::size_t i {0};
+    for (; i + 16 <= size; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i y = _mm_xor_si128(
+            _mm_shuffle_epi8(low, _mm_and_si128(x, mask))
+            , _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(x, 4), mask))
+        );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(y, shift));
+    }
+    affineScalar(t, in + i, out + i, size - i);
+}
+
+__attribute__((target("avx2")))
+inline auto affineAvx2(const TAffineNibbleTables& t, const std::byte* in, std::byte* out, std::size_t size) -> void {
+    const __m256i low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(t.Low.data())));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(t.High.data())));
+    const __m256i shift = _mm256_set1_epi8(static_cast<char>(t.Shift));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+
+    std::size_t i {0};
+    for (; i + 32 <= size; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i y = _mm256_xor_si256(
+            _mm256_shuffle_epi8(low, _mm256_and_si256(x, mask))
+            , _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask))
+        );
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(y, shift));
+    }
+    affineSsse3(t, in + i, out + i, size - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline auto affineAvx512(const TAffineNibbleTables& t, const std::byte* in, std::byte* out, std::size_t size) -> void {
+    const __m512i low = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_load_si128(reinterpret_cast<const __m128i*>(t.Low.data())));
+    const __m512i high = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_load_si128(reinterpret_cast<const __m128i*>(t.High.data())));
+    const __m512i shift = _mm512_set1_epi8(static_cast<char>(t.Shift));
+    const __m512i mask = _mm512_set1_epi8(0x0F);
+
+    std::size_t i {0};
+    for (; i + 64 <= size; i += 64) {
+        __m512i x = _mm512_loadu_si512(in + i);
+        __m512i y = _mm512_xor_si512(
+            _mm512_shuffle_epi8(low, _mm512_and_si512(x, mask))
+            , _mm512_shuffle_epi8(high, _mm512_and_si512(_mm512_srli_epi16(x, 4), mask))
+        );
+        _mm512_storeu_si512(out + i, _mm512_xor_si512(y, shift));
+    }
+    affineSsse3(t, in + i, out + i, size - i);
+}
+#endif
+
+enum class EAffineKernel {
+    Scalar
+    , Ssse3
+    , Avx2
+    , Avx512
+};
+
+inline auto isAffineKernelSupported(EAffineKernel kernel) -> bool {
+    switch (kernel) {
+        case EAffineKernel::Scalar:
+            return true;
+#ifdef KIMP_HAS_X86_SHUFFLE
+        case EAffineKernel::Ssse3:
+            return __builtin_cpu_supports("ssse3");
+        case EAffineKernel::Avx2:
+            return __builtin_cpu_supports("avx2");
+        case EAffineKernel::Avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+        default:
+            return false;
+    }
+}
+
+inline auto bestAffineKernel() -> EAffineKernel {
+    for (auto kernel : {EAffineKernel::Avx512, EAffineKernel::Avx2, EAffineKernel::Ssse3}) {
+        if (isAffineKernelSupported(kernel)) {
+            return kernel;
+        }
+    }
+    return EAffineKernel::Scalar;
+}
+
+class TAffineByteCipher;
+using TAffineByteCipherPtr = std::shared_ptr<TAffineByteCipher>;
+
+class TAffineByteCipher {
+public:
+    TAffineByteCipher(std::byte a, std::byte b, EAffineKernel kernel = bestAffineKernel())
+        : TAffineByteCipher(a, b, TPolynomial<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1}, kernel)
+    {}
+
+    TAffineByteCipher(std::byte a, std::byte b, const TPolynomial<i64>& base, EAffineKernel kernel = bestAffineKernel())
+        : Field_{base, 8}
+        , KernelKind_{kernel}
+        , Kernel_{ResolveKernel(kernel)}
+    {
+        if (a == std::byte {0}) {
+            throw std::invalid_argument("A part of the key should be invertible, got 0");
+        }
+
+        auto fa = ToElement(a), fb = ToElement(b);
+        auto inverse = Field_.Inverse(fa);
+
+        Encoding_ = BuildTables(fa, fb);
+        Decoding_ = BuildTables(inverse, Field_.Mul(inverse, fb));
+    }
+
+    auto Encode(std::span<const std::byte> in, std::span<std::byte> out) const -> void {
+        Run(Encoding_, in, out);
+    }
+
+    auto Decode(std::span<const std::byte> in, std::span<std::byte> out) const -> void {
+        Run(Decoding_, in, out);
+    }
+
+    auto GetKernel() const -> EAffineKernel {
+        return KernelKind_;
+    }
+
+private:
+    static auto ResolveKernel(EAffineKernel kernel) -> TAffineKernel {
+        if (!isAffineKernelSupported(kernel)) {
+            throw std::invalid_argument("Requested affine cipher kernel is not supported by this CPU");
+        }
+        switch (kernel) {
+#ifdef KIMP_HAS_X86_SHUFFLE
+            case EAffineKernel::Ssse3:
+                return affineSsse3;
+            case EAffineKernel::Avx2:
+                return affineAvx2;
+            case EAffineKernel::Avx512:
+                return affineAvx512;
+#endif
+            default:
+                return affineScalar;
+        }
+    }
+
+    auto Run(const TAffineNibbleTables& tables, std::span<const std::byte> in, std::span<std::byte> out) const -> void {
+        if (out.size() < in.size()) {
+            throw std::invalid_argument("Output buffer is smaller than input");
+        }
+        Kernel_(tables, in.data(), out.data(), in.size());
+    }
+
+    auto ToElement(std::byte v) const -> TGaluaBinaryArithmetic::TElement {
+        TGaluaBinaryArithmetic::TElement e {};
+        e[0] = static_cast<ui64>(v);
+        return e;
+    }
+
+    auto BuildTables(const TGaluaBinaryArithmetic::TElement& a, const TGaluaBinaryArithmetic::TElement& b) const -> TAffineNibbleTables {
+        TAffineNibbleTables tables {};
+        for (ui64 i {0}; i < 16; i++) {
+            tables.Low[i] = static_cast<ui8>(Field_.Mul(a, ToElement(std::byte(i)))[0]);
+            tables.High[i] = static_cast<ui8>(Field_.Mul(a, ToElement(std::byte(i << 4)))[0]);
+        }
+        tables.Shift = static_cast<ui8>(b[0]);
+        return tables;
+    }
+
+private:
+    const TGaluaBinaryArithmetic Field_;
+    const EAffineKernel KernelKind_;
+    const TAffineKernel Kernel_;
+
+    TAffineNibbleTables Encoding_;
+    TAffineNibbleTables Decoding_;
+};
+
+} // namespace kimp::cipher
@@ -4,6 +4,13 @@
 #include <math/field.hpp>
 #include <math/num.hpp>
 #include <math/polynomial.hpp>
+#include <math/static.hpp>
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
 
 namespace kimp {
 
@@ -22,6 +29,9 @@ private:
         , NoAppMode
     };
 
+    // Field of the alphabet cipher, matches CipherBasePolynomial
+    using TCipherField = GF<3, 3, 1, 0, 2, 1>;
+
 private:
     auto ParseCommandLineArguments(int argc, char ** argv) -> EAppMode;
 
@@ -35,18 +45,47 @@ private:
 
     auto IsPolynomialSuitableForGaluaFieldBuilding(const TFieldPtr<TDeductionClass<ui64>>& simpleEndlessFied, const TPolynomialPtr<i64>& p) const -> bool;
 
+    // Shows or exports the operation tables as --format says, nullptr if the export failed
     auto BuildGaluaField(const TPolynomialPtr<i64>& p) const -> TGaluaFieldPtr;
     auto ExploreMultiplicativeGroup(const TGaluaFieldPtr&) const -> void;
 
     auto RunCipherMode() const -> int;
+    auto RunCipherStreamMode() const -> int;
+
+    auto CipherBasePolynomial() const -> TPolynomialPtr<i64>;
+    auto ReadCipherKey(std::ostream& prompt) const -> std::pair<char, char>;
+
+    // Alphabet position of every byte, ui64 max for bytes outside of the alphabet
+    auto BuildCipherSymbolIndex() const -> std::array<ui64, 256>;
+
+    // Maps every byte to its cipher pair, bytes outside of the alphabet stay as is
+    auto BuildAlphabetCipherTable(char aKey, char bKey) const -> std::array<std::byte, 256>;
+
+    // --stats to stderr and --trace to its file once the mode is done
+    auto ReportStats() const -> void;
 
 private:
     ui64 GaluaN_;
     ui64 GaluaP_;
     bool GaluaAutogen_;
+    std::string GaluaTablesFormat_;
+    std::string GaluaExportPrefix_;
+
+    const std::string CipherAlphabet_;
 
     std::string CipherValue_;
     bool CipherIsEncoding_;
+
+    std::string CipherInput_;
+    std::string CipherOutput_;
+    std::string CipherKey_;
+    bool CipherQuiet_;
+    bool CipherBytes_;
+    ui64 CipherThreads_;
+
+    bool Stats_;
+    std::string StatsFormat_;
+    std::string TracePath_;
 };
 
 } // namespace kimp
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KIMP_HAS_X86_CLMUL
+#endif
+
+namespace kimp::math {
+
+struct TCarrylessProduct {
+    ui64 Low;
+    ui64 High;
+};
+
+inline auto clmulPortable(ui64 a, ui64 b) -> TCarrylessProduct {
+    std::array<ui64, 16> lowTable {}, highTable {};
+    for (ui64 i {1}; i < 16; i++) {
+        ui64 bit = i & (~i + 1);
+        ui64 shift = bit == 1 ? 0 : bit == 2 ? 1 : bit == 4 ? 2 : 3;
+        lowTable[i] = lowTable[i ^ bit] ^ (a << shift);
+        highTable[i] = highTable[i ^ bit] ^ (shift ? a >> (64 - shift) : 0);
+    }
+
+    TCarrylessProduct result {0, 0};
+    for (ui64 shift {64}; shift > 0; shift -= 4) {
+        result.High = (result.High << 4) | (result.Low >> 60);
+        result.Low <<= 4;
+
+        ui64 nibble = (b >> (shift - 4)) & 0xF;
+        result.Low ^= lowTable[nibble];
+        result.High ^= highTable[nibble];
+    }
+    return result;
+}
+
+#ifdef KIMP_HAS_X86_CLMUL
+__attribute__((target("pclmul,sse2")))
+inline auto clmulPclmulqdq(ui64 a, ui64 b) -> TCarrylessProduct {
+    __m128i product = _mm_clmulepi64_si128(
+        _mm_set_epi64x(0, static_cast<long long>(a))
+        , _mm_set_epi64x(0, static_cast<long long>(b))
+        , 0x00
+    );
+    return TCarrylessProduct {
+        static_cast<ui64>(_mm_cvtsi128_si64(product))
+        , static_cast<ui64>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product)))
+    };
+}
+#endif
+
+using TCarrylessMulKernel = TCarrylessProduct (*)(ui64, ui64);
+
+inline auto selectCarrylessMulKernel() -> TCarrylessMulKernel {
+#ifdef KIMP_HAS_X86_CLMUL
+    if (__builtin_cpu_supports("pclmul")) {
+        return clmulPclmulqdq;
+    }
+#endif
+    return clmulPortable;
+}
+
+class TGaluaBinaryArithmetic;
+using TGaluaBinaryArithmeticPtr = std::shared_ptr<TGaluaBinaryArithmetic>;
+
+// GF(2^n) with elements bit-packed into 64-bit words: bit k is the
+// coefficient of x^k. Addition is xor, multiplication is a carry-less
+// product reduced by shift-and-xor over the sparse terms of the modulus
+class TGaluaBinaryArithmetic {
+public:
+    static constexpr ui64 MaxWords = 9;
+    static constexpr ui64 MaxDegree = MaxWords * 64;
+
+    using TElement = std::array<ui64, MaxWords>;
+
+    TGaluaBinaryArithmetic(const TPolynomial<i64>& base, ui64 n, TCarrylessMulKernel kernel = selectCarrylessMulKernel())
+        : N_{n}
+        , Words_{(n + 63) / 64}
+        , ClMul_{kernel}
+    {
+        if (n == 0 || n > MaxDegree) {
+            throw std::invalid_argument(fmt::format("Binary Galua field degree should be in [1, {}], got {}", MaxDegree, n));
+        }
+        if (base.Degree() != n || base[n] % 2 == 0) {
+            throw std::invalid_argument("Base polynomial should have degree n and odd leading coefficient");
+        }
+
+        for (ui64 e {0}; e < n; e++) {
+            if (base[e] % 2) {
+                ReductionTerms_.push_back(e);
+            }
+        }
+    }
+
+    auto GetN() const -> ui64 {
+        return N_;
+    }
+
+    auto UsesHardwareClMul() const -> bool {
+#ifdef KIMP_HAS_X86_CLMUL
+        return ClMul_ == clmulPclmulqdq;
+#else
+        return false;
+#endif
+    }
+
+    template <typename T> requires isIntegral<T>
+    auto Pack(const TPolynomial<T>& p) const -> TElement {
+        TElement result {};
+        for (ui64 k {0}; k <= p.Degree(); k++) {
+            if (p[k] % 2 == 0) {
+                continue;
+            }
+            if (k >= N_) {
+                throw std::invalid_argument(fmt::format("Polynomial {} doesn't belong to the field", p.ToString()));
+            }
+            result[k / 64] |= ui64 {1} << (k % 64);
+        }
+        return result;
+    }
+
+    template <typename T = i64> requires isIntegral<T>
+    auto Unpack(const TElement& a) const -> TPolynomial<T> {
+        std::array<T, MaxDegree> coefficients;
+        std::size_t size {0};
+        for (ui64 k {N_}; k > 0; k--) {
+            T coef = (a[(k - 1) / 64] >> ((k - 1) % 64)) & 1;
+            if (coef || size) {
+                coefficients[size++] = coef;
+            }
+        }
+        if (size == 0) {
+            return TPolynomial<T>::template zero<T>();
+        }
+        return TPolynomial<T> {std::span<const T> {coefficients.data(), size}};
+    }
+
+    auto One() const -> TElement {
+        TElement result {};
+        result[0] = 1;
+        return result;
+    }
+
+    auto Sum(const TElement& a, const TElement& b) const -> TElement {
+        TElement result {};
+        for (ui64 i {0}; i < Words_; i++) {
+            result[i] = a[i] ^ b[i];
+        }
+        return result;
+    }
+
+    auto Mul(const TElement& a, const TElement& b) const -> TElement {
+        std::array<ui64, 2 * MaxWords + 1> product {};
+
+        for (ui64 i {0}; i < Words_; i++) {
+            if (a[i] == 0) continue;
+            for (ui64 j {0}; j < Words_; j++) {
+                auto part = ClMul_(a[i], b[j]);
+                product[i + j] ^= part.Low;
+                product[i + j + 1] ^= part.High;
+            }
+        }
+
+        return Reduce(product);
+    }
+
+    auto Pow(TElement a, ui64 e) const -> TElement {
+        TElement result = One();
+        for (; e; e >>= 1) {
+            if (e & 1) result = Mul(result, a);
+            a = Mul(a, a);
+        }
+        return result;
+    }
+
+    // a^(2^n - 2) = a^2 * a^4 * ... * a^(2^(n - 1))
+    auto Inverse(TElement a) const -> TElement {
+        if (IsZero(a)) {
+            throw std::invalid_argument("Zero doesn't have an inverse element");
+        }
+        TElement result = One();
+        for (ui64 i {1}; i < N_; i++) {
+            a = Mul(a, a);
+            result = Mul(result, a);
+        }
+        return result;
+    }
+
+    auto IsZero(const TElement& a) const -> bool {
+        for (ui64 i {0}; i < Words_; i++) {
+            if (a[i]) return false;
+        }
+        return true;
+    }
+
+private:
+    auto Reduce(std::array<ui64, 2 * MaxWords + 1>& c) const -> TElement {
+        for (ui64 i {2 * Words_}; i-- > N_ / 64;) {
+            ui64 from = std::max(i * 64, N_);
+            while (ui64 high = c[i] >> (from - i * 64)) {
+                c[i] ^= high << (from - i * 64);
+                for (ui64 e : ReductionTerms_) {
+                    XorShifted(c, high, from - N_ + e);
+                }
+            }
+        }
+
+        TElement result {};
+        for (ui64 i {0}; i < Words_; i++) {
+            result[i] = c[i];
+        }
+        return result;
+    }
+
+    static auto XorShifted(std::array<ui64, 2 * MaxWords + 1>& c, ui64 w, ui64 shift) -> void {
+        ui64 word = shift / 64, bit = shift % 64;
+        c[word] ^= w << bit;
+        if (bit) {
+            c[word + 1] ^= w >> (64 - bit);
+        }
+    }
+
+private:
+    const ui64 N_;
+    const ui64 Words_;
+    const TCarrylessMulKernel ClMul_;
+
+    std::vector<ui64> ReductionTerms_;
+};
+
+} // namespace kimp::math
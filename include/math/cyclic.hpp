@@ -0,0 +1,160 @@
+#pragma once
+
+#include <math/gcd.hpp>
+#include <math/num.hpp>
+#include <math/operation.hpp>
+#include <math/polynomial.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace kimp::math {
+
+// Powers g^k of a field element for k in [0, count) in increasing k, every
+// step costs one multiplication. With a nonzero coprime only exponents
+// coprime to it are yielded: for coprime = ord(g) those are exactly the
+// generators of <g>. Skipped exponents cost a gcd only, the iterator jumps
+// over a gap d by g^d, and the few gap lengths that occur are cached
+class TGaluaPowerView : public std::ranges::view_interface<TGaluaPowerView> {
+public:
+    class TIterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TPolynomial<i64>;
+        using difference_type = std::ptrdiff_t;
+
+        TIterator() = default;
+
+        TIterator(const TGaluaPowerView* view, ui64 k)
+            : View_{view}
+            , K_{k}
+        {
+            if (K_ < View_->Count_) {
+                Power_ = TPolynomial<i64> {1};
+                if (!View_->Accepts(K_)) {
+                    Advance();
+                }
+            }
+        }
+
+        auto operator*() const -> const TPolynomial<i64>& {
+            return *Power_;
+        }
+
+        // Exponent of the current power
+        auto Exponent() const -> ui64 {
+            return K_;
+        }
+
+        auto operator++() -> TIterator& {
+            Advance();
+            return *this;
+        }
+
+        auto operator++(int) -> TIterator {
+            auto copy = *this;
+            Advance();
+            return copy;
+        }
+
+        auto operator==(const TIterator& it) const -> bool {
+            return K_ == it.K_;
+        }
+
+    private:
+        auto Advance() -> void {
+            ui64 next = K_ + 1;
+            while (next < View_->Count_ && !View_->Accepts(next)) {
+                next++;
+            }
+            if (next < View_->Count_) {
+                Power_ = View_->Mul_->Apply(*Power_, Step(next - K_));
+            }
+            K_ = next;
+        }
+
+        // g^d, gaps between coprime exponents are short, so the cache is too
+        auto Step(ui64 d) -> const TPolynomial<i64>& {
+            while (Steps_.size() < d) {
+                Steps_.push_back(Steps_.empty() ? View_->Base_ : View_->Mul_->Apply(Steps_.back(), View_->Base_));
+            }
+            return Steps_[d - 1];
+        }
+
+    private:
+        const TGaluaPowerView* View_ {nullptr};
+        ui64 K_ {0};
+        std::optional<TPolynomial<i64>> Power_;
+        std::vector<TPolynomial<i64>> Steps_;
+    };
+
+    TGaluaPowerView(TGaluaMulOperationPtr<i64> mul, TPolynomial<i64> base, ui64 count, ui64 coprime = 0)
+        : Mul_{std::move(mul)}
+        , Base_{std::move(base)}
+        , Count_{count}
+        , Coprime_{coprime}
+    {}
+
+    auto begin() const -> TIterator {
+        return TIterator {this, 0};
+    }
+
+    auto end() const -> TIterator {
+        return TIterator {this, Count_};
+    }
+
+    auto GetBase() const -> const TPolynomial<i64>& {
+        return Base_;
+    }
+
+private:
+    auto Accepts(ui64 k) const -> bool {
+        return Coprime_ == 0 || gcd(k, Coprime_) == 1;
+    }
+
+private:
+    TGaluaMulOperationPtr<i64> Mul_;
+    TPolynomial<i64> Base_;
+    ui64 Count_;
+    ui64 Coprime_;
+};
+
+// Subgroup of the cyclic F* of the given order, the only one of that order
+class TGaluaSubgroup {
+public:
+    TGaluaSubgroup(TGaluaMulOperationPtr<i64> mul, TPolynomial<i64> generator, ui64 order)
+        : Mul_{std::move(mul)}
+        , Generator_{std::move(generator)}
+        , Order_{order}
+    {}
+
+    auto GetOrder() const -> ui64 {
+        return Order_;
+    }
+
+    auto GetGenerator() const -> const TPolynomial<i64>& {
+        return Generator_;
+    }
+
+    // 1, h, ..., h^(d - 1)
+    auto GetElements() const -> TGaluaPowerView {
+        return TGaluaPowerView {Mul_, Generator_, Order_};
+    }
+
+    // Elements of order exactly d: h^k with gcd(k, d) = 1
+    auto GetGenerators() const -> TGaluaPowerView {
+        return TGaluaPowerView {Mul_, Generator_, Order_, Order_};
+    }
+
+private:
+    TGaluaMulOperationPtr<i64> Mul_;
+    TPolynomial<i64> Generator_;
+    ui64 Order_;
+};
+
+} // namespace kimp::math
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <math/abs.hpp>
+#include <math/modular.hpp>
 #include <math/num.hpp>
 
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <stdexcept>
@@ -21,16 +23,12 @@ class TDeductionClass {
 public:
     constexpr TDeductionClass(T a, T n)
         : A_{a}
-        , N_{n}
-    {
-        if (a >= n) {
-            throw std::invalid_argument("A cannot be more than N");
-        }
-    }
+        , Modulus_{ValidatedModulus(a, n)}
+    {}
 
     TDeductionClass(const TDeductionClass<T>& dc)
         : A_{dc.A_}
-        , N_{dc.N_}
+        , Modulus_{dc.Modulus_}
         {}
 
     auto GetA() const -> T {
@@ -38,40 +36,67 @@ public:
     }
 
     auto GetN() const -> T {
-        return N_;
+        return static_cast<T>(Modulus_.GetN());
     }
 
     template <typename U> requires isIntegral<U>
     auto isIn(U v) const -> bool {
+        T n = GetN();
         if (A_ == 0) {
-            return abs(v) % N_ == 0;
+            return abs(v) % n == 0;
         }
-        return (((v % N_) + N_) % N_) == A_;
+        return (((v % n) + n) % n) == A_;
     }
 
     auto operator+(const TDeductionClass<T>& dc) const -> TDeductionClass<T> {
-        return TDeductionClass<T> {(this->A_ + dc.A_) % this->N_, this->N_};
+        return TDeductionClass<T> {static_cast<T>(Modulus_.Add(this->A_, dc.A_)), Modulus_};
     }
 
+    // Barrett reduction of the 128-bit product, no division and no overflow for any N
     auto operator*(const TDeductionClass<T>& dc) const -> TDeductionClass<T> {
-        return TDeductionClass<T> {(this->A_ * dc.A_) % this->N_, this->N_};
+        return TDeductionClass<T> {static_cast<T>(Modulus_.Mul(this->A_, dc.A_)), Modulus_};
     }
 
     auto operator==(const TDeductionClass<T>& dc) const -> bool {
-        return (this->N_ == dc.N_) && (this->A_ == dc.A_);
+        return (this->Modulus_ == dc.Modulus_) && (this->A_ == dc.A_);
     }
 
     auto operator-() const -> TDeductionClass<T> {
-        return TDeductionClass<T> {(this->N_ - this->A_) % this->N_, this->N_};
+        return TDeductionClass<T> {static_cast<T>(Modulus_.Neg(this->A_)), Modulus_};
+    }
+
+    auto Hash() const -> std::size_t {
+        return hashCombine(std::hash<T> {}(GetN()), std::hash<T> {}(A_));
     }
 
     friend std::ostream& operator<<(std::ostream& out, const TDeductionClass<T>& dc) {
-        return out << fmt::format("({} from {})", dc.A_, dc.N_);
+        return out << fmt::format("({} from {})", dc.A_, dc.GetN());
+    }
+
+private:
+    // Results of operations share the reduction constants of their operands
+    constexpr TDeductionClass(T a, const TBarrett& modulus)
+        : A_{a}
+        , Modulus_{modulus}
+    {}
+
+    static constexpr auto ValidatedModulus(T a, T n) -> TBarrett {
+        if (a >= n) {
+            throw std::invalid_argument("A cannot be more than N");
+        }
+        return TBarrett {n};
     }
 
 private:
     const T A_;
-    const T N_;
+    const TBarrett Modulus_;
 };
 
 } // namespace kimp::math
+
+template <typename T> requires kimp::math::isUnsignedIntegral<T>
+struct std::hash<kimp::math::TDeductionClass<T>> {
+    auto operator()(const kimp::math::TDeductionClass<T>& dc) const noexcept -> std::size_t {
+        return dc.Hash();
+    }
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <math/modular.hpp>
+#include <math/multiply.hpp>
+#include <math/num.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace kimp::math {
+
+// Point counts and degrees from which multipoint evaluation and products of
+// GF(p) polynomials switch from quadratic algorithms. Tune them per machine
+struct TPolynomialEvalThresholds {
+    std::size_t SubproductTree {1 << 13};
+    std::size_t NttMod {1 << 9};
+};
+
+inline TPolynomialEvalThresholds polynomialEvalThresholds {};
+
+namespace NPrivate {
+
+// Coefficients over GF(p) listed from the lowest degree, without leading zeroes
+using TDigits = std::vector<ui64>;
+
+inline auto trim(TDigits& a) -> void {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+inline auto powMod(ui64 a, ui64 e, const TBarrett& p) -> ui64 {
+    return p.Pow(a % p.GetN(), e);
+}
+
+// r -= c * x^shift * b
+inline auto subMulShifted(TDigits& r, const TDigits& b, ui64 c, std::size_t shift, const TBarrett& p) -> void {
+    if (r.size() < b.size() + shift) {
+        r.resize(b.size() + shift, 0);
+    }
+    for (std::size_t i {0}; i < b.size(); i++) {
+        r[i + shift] = p.Sub(r[i + shift], p.Mul(b[i], c));
+    }
+}
+
+// a mod b, b should be non zero
+inline auto remainder(TDigits a, const TDigits& b, const TBarrett& p) -> TDigits {
+    ui64 leadInverse = powMod(b.back(), p.GetN() - 2, p);
+    while (a.size() >= b.size()) {
+        subMulShifted(a, b, p.Mul(a.back(), leadInverse), a.size() - b.size(), p);
+        trim(a);
+    }
+    return a;
+}
+
+inline auto mulMod(std::span<const ui64> a, std::span<const ui64> b, const TBarrett& p) -> TDigits {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+
+    TDigits product (a.size() + b.size() - 1, 0);
+    if (std::min(a.size(), b.size()) >= polynomialEvalThresholds.NttMod) {
+        nttMulMod(a, b, product, p);
+    } else {
+        for (std::size_t i {0}; i < a.size(); i++) {
+            for (std::size_t j {0}; j < b.size(); j++) {
+                product[i + j] = p.MulAdd(a[i], b[j], product[i + j]);
+            }
+        }
+    }
+    trim(product);
+    return product;
+}
+
+// g with f g = 1 mod x^k by Newton's iteration g = g (2 - f g), each step
+// doubles the number of correct terms. f[0] should be invertible
+inline auto inverseSeries(const TDigits& f, std::size_t k, const TBarrett& p) -> TDigits {
+    TDigits g {powMod(f[0], p.GetN() - 2, p)};
+    for (std::size_t length {1}; length < k;) {
+        length = std::min(2 * length, k);
+        auto t = mulMod({f.data(), std::min(f.size(), length)}, g, p);
+        t.resize(length, 0);
+        for (auto& c : t) {
+            c = p.Neg(c);
+        }
+        t[0] = p.Add(t[0], 2 % p.GetN());
+        g = mulMod(g, t, p);
+        g.resize(length, 0);
+    }
+    trim(g);
+    return g;
+}
+
+// a mod b for a monic b: the reversed quotient is rev(a) / rev(b) as a
+// power series, so division costs a couple of products
+inline auto remainderMonic(TDigits a, const TDigits& b, const TBarrett& p) -> TDigits {
+    if (a.size() < b.size()) {
+        return a;
+    }
+    std::size_t quotientSize = a.size() - b.size() + 1;
+    if (std::min(quotientSize, b.size()) < polynomialEvalThresholds.NttMod) {
+        return remainder(std::move(a), b, p);
+    }
+
+    TDigits reversedA (a.rbegin(), a.rbegin() + quotientSize);
+    TDigits reversedB (b.rbegin(), b.rbegin() + std::min(b.size(), quotientSize));
+    auto quotient = mulMod(reversedA, inverseSeries(reversedB, quotientSize, p), p);
+    quotient.resize(quotientSize, 0);
+    std::reverse(quotient.begin(), quotient.end());
+
+    auto product = mulMod(quotient, b, p);
+    a.resize(b.size() - 1);
+    for (std::size_t i {0}; i < a.size() && i < product.size(); i++) {
+        a[i] = p.Sub(a[i], product[i]);
+    }
+    trim(a);
+    return a;
+}
+
+// Horner's rule for a block of points at once, the independent chains keep
+// the multiplier busy while a single one waits for its reductions
+inline auto hornerAll(std::span<const ui64> f, std::span<const ui64> points, std::span<ui64> out, const TBarrett& p) -> void {
+    constexpr std::size_t Lanes = 8;
+
+    std::size_t i {0};
+    for (; i + Lanes <= points.size(); i += Lanes) {
+        std::array<ui64, Lanes> values {};
+        for (std::size_t k {f.size()}; k-- > 0;) {
+            for (std::size_t l {0}; l < Lanes; l++) {
+                values[l] = p.MulAdd(values[l], points[i + l], f[k]);
+            }
+        }
+        std::copy(values.begin(), values.end(), out.begin() + i);
+    }
+    for (; i < points.size(); i++) {
+        ui64 value {0};
+        for (std::size_t k {f.size()}; k-- > 0;) {
+            value = p.MulAdd(value, points[i], f[k]);
+        }
+        out[i] = value;
+    }
+}
+
+// Node v holds the product of (x - point) over its range of points, children
+// are 2v + 1 and 2v + 2. Ranges short enough for Horner aren't split
+class TSubproductTree {
+public:
+    static constexpr std::size_t LeafSize = 32;
+
+    TSubproductTree(std::span<const ui64> points, const TBarrett& p)
+        : Points_{points}
+        , P_{p}
+    {
+        Build(0, 0, points.size());
+    }
+
+    // f should be reduced modulo p
+    auto Evaluate(TDigits f, std::span<ui64> out) const -> void {
+        Descend(std::move(f), 0, 0, Points_.size(), out);
+    }
+
+private:
+    auto Build(std::size_t node, std::size_t begin, std::size_t end) -> void {
+        if (node >= Nodes_.size()) {
+            Nodes_.resize(node + 1);
+        }
+        if (end - begin <= LeafSize) {
+            TDigits product {1};
+            for (std::size_t i {begin}; i < end; i++) {
+                // product * (x - point)
+                product.insert(product.begin(), 0);
+                for (std::size_t k {0}; k + 1 < product.size(); k++) {
+                    product[k] = P_.Sub(product[k], P_.Mul(product[k + 1], Points_[i]));
+                }
+            }
+            Nodes_[node] = std::move(product);
+            return;
+        }
+
+        std::size_t middle = begin + (end - begin) / 2;
+        Build(2 * node + 1, begin, middle);
+        Build(2 * node + 2, middle, end);
+        Nodes_[node] = mulMod(Nodes_[2 * node + 1], Nodes_[2 * node + 2], P_);
+    }
+
+    auto Descend(TDigits f, std::size_t node, std::size_t begin, std::size_t end, std::span<ui64> out) const -> void {
+        f = remainderMonic(std::move(f), Nodes_[node], P_);
+        if (end - begin <= LeafSize) {
+            hornerAll(f, Points_.subspan(begin, end - begin), out.subspan(begin, end - begin), P_);
+            return;
+        }
+
+        std::size_t middle = begin + (end - begin) / 2;
+        Descend(f, 2 * node + 1, begin, middle, out);
+        Descend(std::move(f), 2 * node + 2, middle, end, out);
+    }
+
+private:
+    const std::span<const ui64> Points_;
+    const TBarrett P_;
+    std::vector<TDigits> Nodes_;
+};
+
+// f at every point modulo p, points should be reduced modulo p. Horner costs
+// deg f operations per point, the subproduct tree pays off once both the
+// degree and the number of points are large; points then go by chunks about
+// as long as f, so every tree reduces f just a bit
+inline auto evaluateAll(const TDigits& f, std::span<const ui64> points, std::span<ui64> out, const TBarrett& p) -> void {
+    std::size_t threshold = polynomialEvalThresholds.SubproductTree;
+    if (f.size() < threshold || points.size() < threshold || p.GetN() == 1) {
+        hornerAll(f, points, out, p);
+        return;
+    }
+
+    for (std::size_t begin {0}; begin < points.size(); begin += f.size()) {
+        std::size_t size = std::min(f.size(), points.size() - begin);
+        TSubproductTree tree {points.subspan(begin, size), p};
+        tree.Evaluate(f, out.subspan(begin, size));
+    }
+}
+
+} // namespace NPrivate
+
+} // namespace kimp::math
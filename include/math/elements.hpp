@@ -0,0 +1,210 @@
+#pragma once
+
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+#include <math/rank.hpp>
+#include <math/set.hpp>
+#include <utils/stats.hpp>
+
+#include <fmt/format.h>
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+
+namespace kimp::math {
+
+// Random access range over GF(p^n) elements in rank order, the i-th
+// element is computed from i on access so nothing is stored
+class TGaluaElementView : public std::ranges::view_interface<TGaluaElementView> {
+public:
+    class TIterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TPolynomial<i64>;
+        using difference_type = std::ptrdiff_t;
+
+        TIterator() = default;
+
+        TIterator(ui64 p, ui64 rank)
+            : P_{p}
+            , Rank_{rank}
+        {}
+
+        auto operator*() const -> TPolynomial<i64> {
+            return rankToPolynomial(Rank_, P_);
+        }
+
+        auto operator[](difference_type n) const -> TPolynomial<i64> {
+            return *(*this + n);
+        }
+
+        auto operator++() -> TIterator& {
+            ++Rank_;
+            return *this;
+        }
+
+        auto operator++(int) -> TIterator {
+            auto copy = *this;
+            ++Rank_;
+            return copy;
+        }
+
+        auto operator--() -> TIterator& {
+            --Rank_;
+            return *this;
+        }
+
+        auto operator--(int) -> TIterator {
+            auto copy = *this;
+            --Rank_;
+            return copy;
+        }
+
+        auto operator+=(difference_type n) -> TIterator& {
+            Rank_ += static_cast<ui64>(n);
+            return *this;
+        }
+
+        auto operator-=(difference_type n) -> TIterator& {
+            Rank_ -= static_cast<ui64>(n);
+            return *this;
+        }
+
+        friend auto operator+(TIterator it, difference_type n) -> TIterator {
+            return it += n;
+        }
+
+        friend auto operator+(difference_type n, TIterator it) -> TIterator {
+            return it += n;
+        }
+
+        friend auto operator-(TIterator it, difference_type n) -> TIterator {
+            return it -= n;
+        }
+
+        friend auto operator-(const TIterator& a, const TIterator& b) -> difference_type {
+            return static_cast<difference_type>(a.Rank_ - b.Rank_);
+        }
+
+        auto operator==(const TIterator& it) const -> bool {
+            return Rank_ == it.Rank_;
+        }
+
+        auto operator<=>(const TIterator& it) const -> std::strong_ordering {
+            return Rank_ <=> it.Rank_;
+        }
+
+    private:
+        ui64 P_ {2};
+        ui64 Rank_ {0};
+    };
+
+    TGaluaElementView() = default;
+
+    TGaluaElementView(ui64 p, ui64 size)
+        : P_{p}
+        , Size_{size}
+    {}
+
+    auto begin() const -> TIterator {
+        return TIterator {P_, 0};
+    }
+
+    auto end() const -> TIterator {
+        return TIterator {P_, Size_};
+    }
+
+    auto size() const -> std::size_t {
+        return Size_;
+    }
+
+    auto at(ui64 i) const -> TPolynomial<i64> {
+        if (i >= Size_) {
+            throw std::out_of_range(fmt::format("Field has {} elements, requested #{}", Size_, i));
+        }
+        return rankToPolynomial(i, P_);
+    }
+
+private:
+    ui64 P_ {2};
+    ui64 Size_ {0};
+};
+
+class TGaluaElementSet;
+using TGaluaElementSetPtr = std::shared_ptr<TGaluaElementSet>;
+
+// All polynomials of degree below n over GF(p), membership is decided by
+// looking at the coefficients instead of searching through stored elements
+class TGaluaElementSet : public IFiniteSet<TPolynomial<i64>> {
+public:
+    TGaluaElementSet(ui64 p, ui64 n, ui64 size)
+        : P_{p}
+        , N_{n}
+        , View_{p, size}
+    {}
+
+    virtual bool contains(const TPolynomial<i64>& e) const override {
+        KIMP_STATS_COUNT(ContainsProbe);
+        if (e.Degree() >= N_ || (e.Degree() && e[e.Degree()] == 0)) {
+            return false;
+        }
+        for (ui64 k {0}; k <= e.Degree(); k++) {
+            if (e[k] < 0 || static_cast<ui64>(e[k]) >= P_) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    virtual std::size_t Size() const override {
+        return View_.size();
+    }
+
+    virtual TPolynomial<i64> At(std::size_t i) const override {
+        return View_.at(i);
+    }
+
+    auto GetP() const -> ui64 {
+        return P_;
+    }
+
+    auto GetN() const -> ui64 {
+        return N_;
+    }
+
+    auto GetView() const -> TGaluaElementView {
+        return View_;
+    }
+
+    virtual ~TGaluaElementSet() {}
+
+private:
+    virtual void PrintTo(std::ostream& out) const override {
+        out << '{';
+
+        for (auto it = View_.begin(); it != View_.end(); ++it) {
+            out << *it;
+            if (it + 1 != View_.end()) {
+                out << ", ";
+            }
+        }
+
+        out << '}';
+    }
+
+private:
+    const ui64 P_;
+    const ui64 N_;
+    const TGaluaElementView View_;
+};
+
+} // namespace kimp::math
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<kimp::math::TGaluaElementView> = true;
@@ -4,13 +4,30 @@
 #include "math/polynomial.hpp"
 #include "math/structure.hpp"
 #include <math/set.hpp>
+#include <math/binary.hpp>
+#include <math/cyclic.hpp>
 #include <math/deduction.hpp>
+#include <math/elements.hpp>
+#include <math/gcd.hpp>
+#include <math/irreducible.hpp>
+#include <math/logtable.hpp>
+#include <math/modular.hpp>
 #include <math/num.hpp>
+#include <math/packed.hpp>
 #include <math/prime.hpp>
+#include <math/rank.hpp>
 #include <math/ring.hpp>
+#include <math/static.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace kimp::math {
@@ -70,28 +87,34 @@ private:
 template <>
 class TField<TPolynomial<i64>> {
 public:
-    TField(const TPolynomialPtr<i64>& base, ui64 p, ui64 n)
+    static constexpr ui64 DefaultLogTableMemoryBudget = 64 * 1024 * 1024;
+
+    TField(const TPolynomialPtr<i64>& base, ui64 p, ui64 n, ui64 logTableMemoryBudget = DefaultLogTableMemoryBudget)
         : P_{p}
         , N_{n}
-        , Base_{base}
-        , SumOperation_{std::make_shared<TGaluaSumOperation<i64>>(p)}
-        , MulOperation_{std::make_shared<TGaluaMulOperation<i64>>(base, p)}
+        , Base_{ValidatedBase(base, p, n)}
+        , Packing_{TGaluaPacking<ui64>::Fits(p, n) ? std::make_shared<TGaluaPacking<ui64>>(*Base_, p, n) : nullptr}
+        , Q_{FieldSize(p, n)}
+        , Elements_{std::make_shared<TGaluaElementSet>(p, n, Q_)}
+        , LogTable_{BuildLogTable(logTableMemoryBudget)}
+        , Binary_{p == 2 ? std::make_shared<TGaluaBinaryArithmetic>(*Base_, n) : nullptr}
+        , StaticTables_{findGaluaStaticTables(*Base_, p, n)}
+        , SumOperation_{std::make_shared<TGaluaSumOperation<i64>>(p, LogTable_, Packing_, StaticTables_)}
+        , MulOperation_{std::make_shared<TGaluaMulOperation<i64>>(Base_, p, LogTable_, Packing_, Binary_, StaticTables_)}
     {
-        auto polynomials = GeneratePolinomialsForRing();
-
         auto zero = TPolynomial<i64>::zero<i64>();
         auto one = TPolynomial<i64>::one<i64>();
     
         PolynomialsRing_ = std::make_shared<TRing<TPolynomial<i64>>>(
-            polynomials,
+            Elements_,
             std::make_shared<TAlgebraicStructure<TPolynomial<i64>>>(
-                polynomials,
+                Elements_,
                 SumOperation_,
                 zero,
                 one
             ),
             std::make_shared<TAlgebraicStructure<TPolynomial<i64>>>(
-                polynomials,
+                Elements_,
                 MulOperation_,
                 zero,
                 one
@@ -99,8 +122,216 @@ public:
         );
     }
 
-    auto GetElements() const -> std::vector<TPolynomial<i64>> {
-        return std::dynamic_pointer_cast<TStaticSet<TPolynomial<i64>>>(PolynomialsRing_->GetElements())->GetElements();
+    // Elements are computed on access, the view is cheap to copy
+    auto GetElements() const -> TGaluaElementView {
+        RequireIndexed();
+        return Elements_->GetView();
+    }
+
+    // Fields of 2^64 elements and more, like GF(2^571), are still built and
+    // do arithmetic, but elements have no ranks and F* has no known order
+    auto IsIndexed() const -> bool {
+        return Q_ != 0;
+    }
+
+    auto Size() const -> ui64 {
+        RequireIndexed();
+        return Q_;
+    }
+
+    // Elements are indexed by rank: coefficients read as a base-p number, highest degree first
+    auto IndexOf(const TPolynomial<i64>& e) const -> ui64 {
+        RequireIndexed();
+        if (!e.isZero() && e.Degree() >= N_) {
+            throw std::invalid_argument(fmt::format("Polynomial {} doesn't belong to the field", e.ToString()));
+        }
+        return polynomialToRank(e, P_);
+    }
+
+    auto At(ui64 index) const -> TPolynomial<i64> {
+        RequireIndexed();
+        return Elements_->GetView().at(index);
+    }
+
+    // Compile time or log table lookup for small fields, a^(2^n - 2) for binary ones, extended Euclid otherwise
+    auto Inverse(const TPolynomial<i64>& a) const -> TPolynomial<i64> {
+        if (StaticTables_) {
+            if (ui64 rank = polynomialToRank(a, P_); rank < StaticTables_->Size()) {
+                return rankToPolynomial(StaticTables_->Inverse(rank), P_);
+            }
+        }
+        if (LogTable_) {
+            if (ui64 rank = polynomialToRank(a, P_); rank < LogTable_->Size()) {
+                return rankToPolynomial(LogTable_->Inverse(rank), P_);
+            }
+        }
+        if (Binary_ && a.Degree() < N_) {
+            return Binary_->Unpack(Binary_->Inverse(Binary_->Pack(a)));
+        }
+        return polynomialModInverse(a, *Base_, P_);
+    }
+
+    // Log table lookup, packed words or plain polynomials by square and multiply
+    auto Pow(const TPolynomial<i64>& a, ui64 e) const -> TPolynomial<i64> {
+        if (LogTable_) {
+            if (ui64 rank = polynomialToRank(a, P_); rank < LogTable_->Size()) {
+                return rankToPolynomial(LogTable_->Pow(rank, e), P_);
+            }
+        }
+        if (Binary_) {
+            return Binary_->Unpack(Binary_->Pow(Binary_->Pack(a), e));
+        }
+        if (Packing_) {
+            return Packing_->Unpack(PackedPow(Packing_->Pack(a), e));
+        }
+        return PowBy(a, TPolynomial<i64> {1}, e, [this] (const auto& x, const auto& y) {
+            return MulOperation_->Apply(x, y);
+        });
+    }
+
+    // Order of a in F*: (q - 1) / gcd(log a, q - 1) with a log table,
+    // otherwise for every prime power r^k of q - 1 the r-part a^((q - 1) / r^k)
+    // is raised to r until it turns into 1, so O(log q) powers overall
+    auto Order(const TPolynomial<i64>& a) const -> ui64 {
+        if (a.isZero()) {
+            throw std::invalid_argument("Zero has no multiplicative order");
+        }
+        RequireIrreducible();
+        if (LogTable_) {
+            if (ui64 rank = polynomialToRank(a, P_); rank < LogTable_->Size()) {
+                return (Q_ - 1) / gcd(LogTable_->Log(rank), Q_ - 1);
+            }
+        }
+        if (Binary_) {
+            return OrderBy(Binary_->Pack(a), Binary_->One(), [this] (const auto& x, ui64 e) {
+                return Binary_->Pow(x, e);
+            });
+        }
+        if (Packing_) {
+            return OrderBy(Packing_->Pack(a), Packing_->FromRank(1), [this] (ui64 x, ui64 e) {
+                return PackedPow(x, e);
+            });
+        }
+        return OrderBy(a, TPolynomial<i64> {1}, [this] (const auto& x, ui64 e) {
+            return Pow(x, e);
+        });
+    }
+
+    // No a^((q - 1) / r) is 1 for a prime r dividing q - 1
+    auto IsGenerator(const TPolynomial<i64>& a) const -> bool {
+        RequireIrreducible();
+        if (a.isZero()) {
+            return false;
+        }
+        if (LogTable_) {
+            if (ui64 rank = polynomialToRank(a, P_); rank < LogTable_->Size()) {
+                return gcd(LogTable_->Log(rank), Q_ - 1) == 1;
+            }
+        }
+
+        TPolynomial<i64> one {1};
+        for (auto [r, k] : GetGroupOrderFactors()) {
+            if (Pow(a, (Q_ - 1) / r) == one) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Generator of the log table if there is one, otherwise the first one by
+    // rank: they make phi(q - 1) / (q - 1) = Omega(1 / log log q) of F*, so
+    // only a few candidates are tested
+    auto FindGenerator() const -> TPolynomial<i64> {
+        RequireIrreducible();
+        if (LogTable_) {
+            return rankToPolynomial(LogTable_->Generator(), P_);
+        }
+        for (ui64 rank {1}; rank < Q_; rank++) {
+            if (auto a = rankToPolynomial(rank, P_); IsGenerator(a)) {
+                return a;
+            }
+        }
+        throw std::logic_error(fmt::format("F(p = {}, n = {}) has no generator", P_, N_));
+    }
+
+    // g^k for k coprime to q - 1, every generator exactly once
+    auto AllGenerators() const -> TGaluaPowerView {
+        return TGaluaPowerView {MulOperation_, FindGenerator(), Q_ - 1, Q_ - 1};
+    }
+
+    // F* is cyclic, so its subgroups are <g^((q - 1) / d)> for the divisors d
+    // of q - 1, one per divisor. Costs a power per subgroup whatever q is
+    auto Subgroup(ui64 order) const -> TGaluaSubgroup {
+        RequireIrreducible();
+        if (order == 0 || (Q_ - 1) % order != 0) {
+            throw std::invalid_argument(fmt::format("F* of order {} has no subgroup of order {}", Q_ - 1, order));
+        }
+        return TGaluaSubgroup {MulOperation_, Pow(FindGenerator(), (Q_ - 1) / order), order};
+    }
+
+    // Ascending by order, from {1} to F* itself
+    auto Subgroups() const -> std::vector<TGaluaSubgroup> {
+        RequireIrreducible();
+        std::vector<ui64> divisors {1};
+        for (auto [r, k] : GetGroupOrderFactors()) {
+            std::size_t size = divisors.size();
+            for (ui64 i {0}, rPower {r}; i < k; i++, rPower *= r) {
+                for (std::size_t j {0}; j < size; j++) {
+                    divisors.push_back(divisors[j] * rPower);
+                }
+            }
+        }
+        std::sort(divisors.begin(), divisors.end());
+
+        auto g = FindGenerator();
+        std::vector<TGaluaSubgroup> subgroups;
+        subgroups.reserve(divisors.size());
+        for (ui64 d : divisors) {
+            subgroups.emplace_back(MulOperation_, Pow(g, (Q_ - 1) / d), d);
+        }
+        return subgroups;
+    }
+
+    // Ranks of F* elements keyed by their orders, ascending in both. Orders
+    // are computed by threads over interleaved ranks
+    auto GroupByOrder(std::size_t threads = 1) const -> std::map<ui64, std::vector<ui64>> {
+        RequireIrreducible();
+        threads = std::max<std::size_t>(1, std::min<ui64>(threads, Q_ - 1));
+        std::vector<ui64> orders (Q_, 0);
+        std::vector<std::exception_ptr> errors (threads);
+        auto work = [&] (std::size_t shift) {
+            try {
+                for (ui64 rank {1 + shift}; rank < Q_; rank += threads) {
+                    orders[rank] = Order(rankToPolynomial(rank, P_));
+                }
+            } catch (...) {
+                errors[shift] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i {1}; i < threads; i++) {
+            workers.emplace_back(work, i);
+        }
+        work(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        std::map<ui64, std::vector<ui64>> groups;
+        for (ui64 rank {1}; rank < Q_; rank++) {
+            groups[orders[rank]].push_back(rank);
+        }
+        return groups;
+    }
+
+    auto GetPacking() const -> TGaluaPackingPtr<ui64> {
+        return Packing_;
     }
 
     auto GetSumOperation() const -> TGaluaSumOperationPtr<i64> {
@@ -111,59 +342,147 @@ public:
         return MulOperation_;
     }
 
+    auto GetLogTable() const -> TGaluaLogTablePtr {
+        return LogTable_;
+    }
+
+    auto GetBinaryArithmetic() const -> TGaluaBinaryArithmeticPtr {
+        return Binary_;
+    }
+
+    // Tables of a TStaticGaluaField instantiation when the base matches one of them
+    auto GetStaticTables() const -> TGaluaStaticTablesPtr {
+        return StaticTables_;
+    }
+
 private:
-    auto GeneratePolinomialsForRing() const -> TStaticSetPtr<TPolynomial<i64>> {
-        std::vector<TPolynomial<i64>> elements;
-        elements.reserve(std::pow(P_, N_));
+    template <typename TElement, typename TMul>
+    static auto PowBy(TElement a, TElement one, ui64 e, TMul mul) -> TElement {
+        TElement result = one;
+        for (; e; e >>= 1) {
+            if (e & 1) result = mul(result, a);
+            if (e > 1) a = mul(a, a);
+        }
+        return result;
+    }
 
-        std::vector<i64> tempPolynomial (N_);
+    auto PackedPow(ui64 a, ui64 e) const -> ui64 {
+        return PowBy(a, Packing_->FromRank(1), e, [this] (ui64 x, ui64 y) {
+            return Packing_->Mul(x, y);
+        });
+    }
 
-        const auto FillTempPolynomial = [&]() {
-            for (std::size_t i {0}; i < tempPolynomial.size(); i++) {
-                tempPolynomial[i] = P_ - 1;
+    template <typename TElement, typename TPow>
+    auto OrderBy(const TElement& a, const TElement& one, TPow pow) const -> ui64 {
+        ui64 order {1};
+        for (auto [r, k] : GetGroupOrderFactors()) {
+            ui64 rPower {1};
+            for (ui64 i {0}; i < k; i++) {
+                rPower *= r;
             }
-        };
+            // The base is irreducible, so the r-part turns into 1 within k steps
+            auto b = pow(a, (Q_ - 1) / rPower);
+            for (ui64 i {0}; i < k && !(b == one); i++, b = pow(b, r)) {
+                order *= r;
+            }
+        }
+        return order;
+    }
 
-        FillTempPolynomial();
+    // Only order queries need q - 1 factored, so it's done on demand
+    auto GetGroupOrderFactors() const -> const std::vector<std::pair<ui64, ui64>>& {
+        RequireIndexed();
+        std::call_once(GroupOrderFactorsOnce_, [this] () {
+            GroupOrderFactors_ = factorize(Q_ - 1);
+        });
+        return GroupOrderFactors_;
+    }
 
-        while (tempPolynomial.size() >= 1) {
-            elements.push_back(TPolynomial<i64> {tempPolynomial});
+    // Orders and generators need F* to be a cyclic group of q - 1 elements,
+    // so the base is tested once on the first such query. Log and compile
+    // time tables are only built for fields
+    auto RequireIrreducible() const -> void {
+        RequireIndexed();
+        std::call_once(IrreducibleOnce_, [this] () {
+            Irreducible_ = LogTable_ || StaticTables_ || isIrreducible(*Base_, P_);
+        });
+        if (!Irreducible_) {
+            throw std::logic_error(fmt::format("Base of F(p = {}, n = {}) isn't irreducible, nonzero elements don't form a group", P_, N_));
+        }
+    }
 
-            auto tempIndex = tempPolynomial.size() - 1;
+    auto RequireIndexed() const -> void {
+        if (Q_ == 0) {
+            throw std::logic_error(fmt::format("F(p = {}, n = {}) has too many elements to index them", P_, N_));
+        }
+    }
 
-            while (tempIndex > 0) {
-                if (tempPolynomial[tempIndex] > 0) {
-                    tempPolynomial[tempIndex]--;
-                    break;
-                }
+    auto BuildLogTable(ui64 memoryBudget) const -> TGaluaLogTablePtr {
+        if (TGaluaLogTable::RequiredMemory(P_, N_) > memoryBudget) {
+            return nullptr;
+        }
+        return TGaluaLogTable::TryBuild(*Base_, P_, N_);
+    }
 
-                tempPolynomial[tempIndex] = P_ - 1;
-                tempIndex--;
-            }
+    static auto ValidatedBase(const TPolynomialPtr<i64>& base, ui64 p, ui64 n) -> TPolynomialPtr<i64> {
+        if (p < 2 || n == 0) {
+            throw std::invalid_argument(fmt::format("Unable to build F(p = {}, n = {})", p, n));
+        }
+        if (!base || base->Degree() != n || (*base)[n] % static_cast<i64>(p) == 0) {
+            throw std::invalid_argument("Base polynomial should have degree n and leading coefficient not divisible by p");
+        }
+        if ((*base)[n] == 1) {
+            return base;
+        }
 
-            if (tempIndex == 0) {
-                if (tempPolynomial[tempIndex] > 1) {
-                    tempPolynomial[tempIndex]--;
-                } else {
-                    tempPolynomial.pop_back();
-                    FillTempPolynomial();
-                }
+        // The monic associate spans the same ideal, and the polynomial
+        // fallback of TGaluaMulOperation divides by the leading coefficient
+        // as integers, which is exact only for 1
+        TBarrett mod {p};
+        auto residue = [p] (i64 c) {
+            return static_cast<ui64>((c % static_cast<i64>(p) + static_cast<i64>(p)) % static_cast<i64>(p));
+        };
+        ui64 inverse = modInverse(residue((*base)[n]), p);
+        std::vector<i64> coefficients (n + 1);
+        for (ui64 k {0}; k <= n; k++) {
+            coefficients[n - k] = static_cast<i64>(mod.Mul(residue((*base)[k]), inverse));
+        }
+        return std::make_shared<TPolynomial<i64>>(coefficients);
+    }
+
+    // Returns 0 when p^n doesn't fit into 64 bits
+    static auto FieldSize(ui64 p, ui64 n) -> ui64 {
+        ui64 q {1};
+        for (ui64 i {0}; i < n; i++) {
+            if (q > std::numeric_limits<ui64>::max() / p) {
+                return 0;
             }
+            q *= p;
         }
-        elements.push_back(TPolynomial<i64>::zero<i64>());
-        std::reverse(elements.begin(), elements.end());
-        
-        return std::make_shared<TStaticSet<TPolynomial<i64>>>(elements);
+        return q;
     }
 
 private:
     const ui64 P_;
     const ui64 N_;
     const TPolynomialPtr<i64> Base_;
+    const TGaluaPackingPtr<ui64> Packing_;
+    const ui64 Q_;
+    const TGaluaElementSetPtr Elements_;
+    const TGaluaLogTablePtr LogTable_;
+    const TGaluaBinaryArithmeticPtr Binary_;
+    const TGaluaStaticTablesPtr StaticTables_;
 
     const TGaluaSumOperationPtr<i64> SumOperation_;
     const TGaluaMulOperationPtr<i64> MulOperation_;
 
+    // Prime powers of q - 1, the order of F*
+    mutable std::vector<std::pair<ui64, ui64>> GroupOrderFactors_;
+    mutable std::once_flag GroupOrderFactorsOnce_;
+
+    mutable bool Irreducible_ {false};
+    mutable std::once_flag IrreducibleOnce_;
+
     TRingPtr<TPolynomial<i64>> PolynomialsRing_;
 };
 
@@ -1,31 +1,258 @@
 #pragma once
 
+#include <math/digits.hpp>
+#include <math/modular.hpp>
 #include <math/num.hpp>
+#include <math/polynomial.hpp>
 
+#include <fmt/format.h>
+
+#include <bit>
+#include <span>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace kimp::math {
 
+namespace NPrivate {
+
+template <typename T> requires isIntegral<T>
+auto magnitude(T v) -> ui64 {
+    if constexpr (isSignedIntegral<T>) {
+        return v < 0 ? ui64 {0} - static_cast<ui64>(static_cast<i64>(v)) : static_cast<ui64>(v);
+    } else {
+        return static_cast<ui64>(v);
+    }
+}
+
+// Stein's algorithm, shifts and subtractions instead of divisions
+inline auto binaryGcd(ui64 a, ui64 b) -> ui64 {
+    if (a == 0 || b == 0) {
+        return a | b;
+    }
+    int shift = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+    do {
+        b >>= std::countr_zero(b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        b -= a;
+    } while (b);
+    return a << shift;
+}
+
+} // namespace NPrivate
+
+// Non negative, gcd(0, 0) = 0
 template <typename T1, typename T2> requires isIntegral<T1> && isIntegral<T2>
 auto gcd(T1 a, T2 b) -> std::common_type_t<T1, T2> {
-    if (b == 0) {
-        return a;
-    }
-    return gcd(b, a % b);
+    return static_cast<std::common_type_t<T1, T2>>(NPrivate::binaryGcd(NPrivate::magnitude(a), NPrivate::magnitude(b)));
 }
 
-template <typename T1, typename T2> requires isSignedIntegral<T1> && isSignedIntegral<T2>
+// (g, x, y) with a x + b y = g = gcd(a, b) by the iterative Euclid. The
+// coefficients are bounded by max(|a|, |b|) / 2g, so they fit into i64 and
+// wrapping arithmetic on the way gives exact values
+template <typename T1, typename T2> requires isIntegral<T1> && isIntegral<T2>
 auto gcdExtended(T1 a, T2 b) -> std::tuple<std::common_type_t<T1, T2>, i64, i64> {
-    if (a == 0) {
-        return std::make_tuple(b, 0, 1);
+    ui64 r0 = NPrivate::magnitude(a), r1 = NPrivate::magnitude(b);
+    ui64 x0 {1}, x1 {0}, y0 {0}, y1 {1};
+    while (r1) {
+        ui64 q = r0 / r1;
+        r0 = std::exchange(r1, r0 - q * r1);
+        x0 = std::exchange(x1, x0 - q * x1);
+        y0 = std::exchange(y1, y0 - q * y1);
+    }
+
+    auto x = static_cast<i64>(x0), y = static_cast<i64>(y0);
+    if constexpr (isSignedIntegral<T1>) {
+        x = a < 0 ? -x : x;
+    }
+    if constexpr (isSignedIntegral<T2>) {
+        y = b < 0 ? -y : y;
+    }
+    return std::make_tuple(static_cast<std::common_type_t<T1, T2>>(r0), x, y);
+}
+
+// a^-1 mod n, a should be coprime to n
+template <typename T> requires isIntegral<T>
+auto modInverse(T a, ui64 n) -> ui64 {
+    if (n == 0) {
+        throw std::invalid_argument("Unable to invert modulo zero");
+    }
+
+    ui64 residue = NPrivate::magnitude(a) % n;
+    if constexpr (isSignedIntegral<T>) {
+        residue = a < 0 && residue ? n - residue : residue;
+    }
+    auto [g, x, y] = gcdExtended(residue, n);
+    if (g != 1) {
+        throw std::invalid_argument(fmt::format("{} is not invertible modulo {}", a, n));
+    }
+    return x < 0 ? n - NPrivate::magnitude(x) % n : static_cast<ui64>(x) % n;
+}
+
+// Montgomery's trick: prefix products, a single inversion of the whole
+// product and two multiplications per value on the way back, so k values
+// cost one inversion and 3(k - 1) multiplications
+inline auto batchModInverse(std::span<const ui64> values, ui64 n) -> std::vector<ui64> {
+    if (values.empty()) {
+        return {};
+    }
+
+    TBarrett mod {n};
+    std::vector<ui64> prefix (values.size()), inverses (values.size());
+    prefix[0] = values[0] % n;
+    for (std::size_t i {1}; i < values.size(); i++) {
+        prefix[i] = mod.Mul(prefix[i - 1], values[i] % n);
+    }
+
+    ui64 inverse;
+    try {
+        inverse = modInverse(prefix.back(), n);
+    } catch (const std::invalid_argument&) {
+        throw std::invalid_argument(fmt::format("Some of {} values are not invertible modulo {}", values.size(), n));
+    }
+    for (std::size_t i {values.size() - 1}; i > 0; i--) {
+        inverses[i] = mod.Mul(inverse, prefix[i - 1]);
+        inverse = mod.Mul(inverse, values[i] % n);
+    }
+    inverses[0] = inverse;
+    return inverses;
+}
+
+namespace NPrivate {
+
+inline auto gcd(TDigits a, TDigits b, const TBarrett& p) -> TDigits {
+    while (!b.empty()) {
+        a = remainder(std::move(a), b, p);
+        std::swap(a, b);
     }
+    return a;
+}
+
+// Inverse of a modulo m by the extended Euclid, empty if there is none.
+// Invariant: s a = r (mod m)
+inline auto inverseDigits(TDigits a, TDigits m, const TBarrett& mod) -> TDigits {
+    TDigits r0 = std::move(m), r1 = remainder(std::move(a), r0, mod);
+    TDigits s0 {}, s1 {1};
+
+    while (r1.size() > 1) {
+        ui64 leadInverse = modInverse(r1.back(), mod.GetN());
+        TDigits quotient (r0.size() - r1.size() + 1, 0);
+        while (r0.size() >= r1.size()) {
+            std::size_t shift = r0.size() - r1.size();
+            ui64 c = mod.Mul(r0.back(), leadInverse);
+            quotient[shift] = c;
+            subMulShifted(r0, r1, c, shift, mod);
+            trim(r0);
+        }
+
+        for (std::size_t i {0}; i < quotient.size(); i++) {
+            if (quotient[i]) subMulShifted(s0, s1, quotient[i], i, mod);
+        }
+        trim(s0);
+
+        std::swap(r0, r1);
+        std::swap(s0, s1);
+    }
+
+    if (r1.empty()) {
+        return {};
+    }
+    ui64 scale = modInverse(r1[0], mod.GetN());
+    for (auto& c : s1) {
+        c = mod.Mul(c, scale);
+    }
+    return s1;
+}
+
+template <typename T>
+auto fromDigits(const TDigits& digits) -> TPolynomial<T> {
+    if (digits.empty()) {
+        return TPolynomial<T>::template zero<T>();
+    }
+    std::vector<T> coefficients (digits.rbegin(), digits.rend());
+    return TPolynomial<T> {coefficients};
+}
+
+template <typename T>
+auto toDigits(const TPolynomial<T>& a, ui64 p) -> TDigits {
+    TDigits digits (a.Degree() + 1);
+    for (std::size_t i {0}; i < digits.size(); i++) {
+        auto c = a[i] % static_cast<T>(p);
+        digits[i] = static_cast<ui64>(c < 0 ? c + static_cast<T>(p) : c);
+    }
+    trim(digits);
+    return digits;
+}
 
-    auto intermediateResult = gcdExtended(b % a, a);
-    return std::make_tuple(
-      std::get<0>(intermediateResult)
-      , std::get<2>(intermediateResult) - (b / a) * std::get<1>(intermediateResult)
-      , std::get<1>(intermediateResult)
-    );
+} // namespace NPrivate
+
+// Inverse of a modulo the irreducible modulus over GF(p), p should be a prime
+template <typename T> requires isIntegral<T>
+auto polynomialModInverse(const TPolynomial<T>& a, const TPolynomial<T>& modulus, ui64 p) -> TPolynomial<T> {
+    TBarrett mod {p};
+    auto inverse = NPrivate::inverseDigits(NPrivate::toDigits(a, p), NPrivate::toDigits(modulus, p), mod);
+    if (inverse.empty()) {
+        throw std::invalid_argument(fmt::format("Polynomial {} is not invertible modulo {}", a.ToString(), modulus.ToString()));
+    }
+    return NPrivate::fromDigits<T>(inverse);
+}
+
+// Monic gcd over GF(p), zero for two zeroes
+template <typename T> requires isIntegral<T>
+auto polynomialGcd(const TPolynomial<T>& a, const TPolynomial<T>& b, ui64 p) -> TPolynomial<T> {
+    TBarrett mod {p};
+    auto g = NPrivate::gcd(NPrivate::toDigits(a, p), NPrivate::toDigits(b, p), mod);
+    if (!g.empty()) {
+        ui64 leadInverse = modInverse(g.back(), p);
+        for (auto& c : g) {
+            c = mod.Mul(c, leadInverse);
+        }
+    }
+    return NPrivate::fromDigits<T>(g);
+}
+
+// Montgomery's trick in GF(p)[x]/(modulus): one extended Euclid and
+// 3(k - 1) products modulo the modulus
+template <typename T> requires isIntegral<T>
+auto batchPolynomialModInverse(std::span<const TPolynomial<T>> values, const TPolynomial<T>& modulus, ui64 p) -> std::vector<TPolynomial<T>> {
+    using namespace NPrivate;
+
+    if (values.empty()) {
+        return {};
+    }
+
+    TBarrett mod {p};
+    TDigits m = toDigits(modulus, p);
+    auto product = [&] (const TDigits& x, const TDigits& y) {
+        return remainder(mulMod(x, y, mod), m, mod);
+    };
+
+    std::vector<TDigits> digits, prefix;
+    digits.reserve(values.size());
+    prefix.reserve(values.size());
+    for (const auto& v : values) {
+        digits.push_back(remainder(toDigits(v, p), m, mod));
+        prefix.push_back(prefix.empty() ? digits.back() : product(prefix.back(), digits.back()));
+    }
+
+    TDigits inverse = inverseDigits(prefix.back(), m, mod);
+    if (inverse.empty()) {
+        throw std::invalid_argument(fmt::format("Some of {} polynomials are not invertible modulo {}", values.size(), modulus.ToString()));
+    }
+
+    std::vector<TPolynomial<T>> inverses (values.size(), TPolynomial<T>::template zero<T>());
+    for (std::size_t i {values.size() - 1}; i > 0; i--) {
+        inverses[i] = fromDigits<T>(product(inverse, prefix[i - 1]));
+        inverse = product(inverse, digits[i]);
+    }
+    inverses[0] = fromDigits<T>(inverse);
+    return inverses;
 }
 
 } // namespace kimp::math
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <math/gcd.hpp>
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+#include <math/prime.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace kimp::math {
+
+class TPolynomialResidueRing;
+using TPolynomialResidueRingPtr = std::shared_ptr<TPolynomialResidueRing>;
+
+// GF(p)[x]/(f) over coefficient vectors listed from the lowest degree, the
+// modulus is made monic so reduction never divides
+class TPolynomialResidueRing {
+public:
+    using TElement = NPrivate::TDigits;
+
+    TPolynomialResidueRing(const TPolynomial<i64>& modulus, ui64 p)
+        : P_{p}
+        , Mod_{p}
+        , Modulus_{NPrivate::toDigits(modulus, p)}
+    {
+        if (p < 2 || p > static_cast<ui64>(std::numeric_limits<i64>::max())) {
+            throw std::invalid_argument(fmt::format("Coefficients modulo {} are not supported", p));
+        }
+        if (Modulus_.size() < 2 || Modulus_.size() != modulus.Degree() + 1) {
+            throw std::invalid_argument(fmt::format("Modulus {} should have degree at least 1 over GF({})", modulus.ToString(), p));
+        }
+
+        ui64 leadInverse = modInverse(Modulus_.back(), p);
+        for (auto& c : Modulus_) {
+            c = Mod_.Mul(c, leadInverse);
+        }
+    }
+
+    auto Degree() const -> ui64 {
+        return Modulus_.size() - 1;
+    }
+
+    auto GetModulus() const -> const TElement& {
+        return Modulus_;
+    }
+
+    auto One() const -> TElement {
+        return Reduce({1});
+    }
+
+    auto X() const -> TElement {
+        return Reduce({0, 1});
+    }
+
+    auto Sub(TElement a, const TElement& b) const -> TElement {
+        NPrivate::subMulShifted(a, b, 1, 0, Mod_);
+        NPrivate::trim(a);
+        return a;
+    }
+
+    auto Mul(const TElement& a, const TElement& b) const -> TElement {
+        if (a.empty() || b.empty()) {
+            return {};
+        }
+        TElement product (a.size() + b.size() - 1, 0);
+        for (std::size_t i {0}; i < a.size(); i++) {
+            if (a[i] == 0) continue;
+            for (std::size_t j {0}; j < b.size(); j++) {
+                product[i + j] = Mod_.MulAdd(a[i], b[j], product[i + j]);
+            }
+        }
+        return Reduce(std::move(product));
+    }
+
+    auto Pow(TElement a, ui64 e) const -> TElement {
+        TElement result = One();
+        for (; e; e >>= 1) {
+            if (e & 1) result = Mul(result, a);
+            a = Mul(a, a);
+        }
+        return result;
+    }
+
+    // a^(p^times), applying the Frobenius map keeps exponents small
+    auto Frobenius(TElement a, ui64 times) const -> TElement {
+        for (ui64 i {0}; i < times; i++) {
+            a = Pow(std::move(a), P_);
+        }
+        return a;
+    }
+
+    auto Gcd(const TElement& a) const -> TElement {
+        return NPrivate::gcd(Modulus_, a, Mod_);
+    }
+
+private:
+    auto Reduce(TElement a) const -> TElement {
+        NPrivate::trim(a);
+        for (std::size_t n = Modulus_.size(); a.size() >= n;) {
+            NPrivate::subMulShifted(a, Modulus_, a.back(), a.size() - n, Mod_);
+            NPrivate::trim(a);
+        }
+        return a;
+    }
+
+private:
+    const ui64 P_;
+    const TBarrett Mod_;
+    TElement Modulus_;
+};
+
+inline constexpr ui64 RootScreenLimit = 64;
+
+// Rabin's test: f of degree n is irreducible over GF(p) iff x^(p^n) = x mod f
+// and gcd(f, x^(p^(n/r)) - x) = 1 for every prime r dividing n
+inline auto isIrreducible(const TPolynomial<i64>& f, ui64 p) -> bool {
+    if (f.Degree() == 0 || f[f.Degree()] % static_cast<i64>(p) == 0) {
+        return false;
+    }
+
+    // A root is a linear factor, for small p trying every one of them is far
+    // cheaper than Frobenius powers and rejects most of random candidates
+    if (f.Degree() > 1 && p <= RootScreenLimit) {
+        std::array<ui64, RootScreenLimit> points;
+        std::iota(points.begin(), points.end(), 0);
+        auto values = f.EvaluateAll({points.data(), p}, p);
+        if (std::find(values.begin(), values.end(), 0) != values.end()) {
+            return false;
+        }
+    }
+
+    TPolynomialResidueRing ring {f, p};
+    ui64 n = ring.Degree();
+    auto x = ring.X();
+
+    auto divisors = primeFactors(n);
+    std::vector<ui64> checkpoints;
+    for (auto r = divisors.rbegin(); r != divisors.rend(); r++) {
+        checkpoints.push_back(n / *r);
+    }
+
+    auto power = x;
+    for (ui64 k {1}, next {0}; k <= n; k++) {
+        power = ring.Frobenius(std::move(power), 1);
+        if (next < checkpoints.size() && checkpoints[next] == k) {
+            if (ring.Gcd(ring.Sub(power, x)).size() != 1) {
+                return false;
+            }
+            next++;
+        }
+    }
+    return power == x;
+}
+
+// x generates the multiplicative group of GF(p)[x]/(f): f is irreducible and
+// x^((q - 1) / r) != 1 for every prime r dividing q - 1 = p^n - 1
+inline auto isPrimitive(const TPolynomial<i64>& f, ui64 p) -> bool {
+    if (!isIrreducible(f, p)) {
+        return false;
+    }
+
+    TPolynomialResidueRing ring {f, p};
+    ui64 order {1};
+    for (ui64 i {0}; i < ring.Degree(); i++) {
+        if (order > std::numeric_limits<ui64>::max() / p) {
+            throw std::invalid_argument(fmt::format("Multiplicative group of F(p = {}, n = {}) is too large", p, ring.Degree()));
+        }
+        order *= p;
+    }
+    order--;
+
+    auto x = ring.X();
+    if (x.empty()) {
+        return false;
+    }
+    for (ui64 r : primeFactors(order)) {
+        if (ring.Pow(x, order / r) == ring.One()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace kimp::math
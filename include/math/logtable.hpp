@@ -0,0 +1,271 @@
+#pragma once
+
+#include <math/gcd.hpp>
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+#include <math/prime.hpp>
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace kimp::math {
+
+class TGaluaLogTable;
+using TGaluaLogTablePtr = std::shared_ptr<TGaluaLogTable>;
+
+// Discrete logarithm tables of GF(p^n) elements addressed by their rank
+// (the base-p number made of polynomial coefficients). Multiplication goes
+// through log/antilog lookups, addition through Zech logarithms
+// Z(k) = log(1 + g^k), so every operation costs a few array reads
+class TGaluaLogTable {
+public:
+    static constexpr ui32 ZechInfinity = std::numeric_limits<ui32>::max();
+
+    // Returns 0 when p^n doesn't fit into 32-bit table entries
+    static auto FieldSize(ui64 p, ui64 n) -> ui64 {
+        ui64 q {1};
+        for (ui64 i {0}; i < n; i++) {
+            if (p == 0 || q > (ZechInfinity - 1) / p) {
+                return 0;
+            }
+            q *= p;
+        }
+        return q;
+    }
+
+    static auto RequiredMemory(ui64 p, ui64 n) -> ui64 {
+        if (ui64 q = FieldSize(p, n); q) {
+            return (3 * q - 2) * sizeof(ui32);
+        }
+        return std::numeric_limits<ui64>::max();
+    }
+
+    // Returns nullptr when the base polynomial doesn't produce a field
+    // (there is no element which powers cover the whole F*)
+    static auto TryBuild(const TPolynomial<i64>& base, ui64 p, ui64 n) -> TGaluaLogTablePtr {
+        if (p < 2 || n == 0 || base.Degree() != n || FieldSize(p, n) == 0) {
+            return nullptr;
+        }
+
+        auto table = TGaluaLogTablePtr {new TGaluaLogTable {p, n}};
+        if (!table->Fill(base)) {
+            return nullptr;
+        }
+        return table;
+    }
+
+    auto Size() const -> ui64 {
+        return Q_;
+    }
+
+    auto Generator() const -> ui64 {
+        return Generator_;
+    }
+
+    auto Log(ui64 a) const -> ui64 {
+        if (a == 0) {
+            throw std::invalid_argument("Logarithm of zero is undefined");
+        }
+        return Log_[a];
+    }
+
+    auto Exp(ui64 i) const -> ui64 {
+        return Antilog_[i % (Q_ - 1)];
+    }
+
+    auto Sum(ui64 a, ui64 b) const -> ui64 {
+        if (a == 0) return b;
+        if (b == 0) return a;
+
+        ui64 la = Log_[a], lb = Log_[b];
+        if (la > lb) {
+            std::swap(la, lb);
+        }
+
+        ui32 zech = Zech_[lb - la];
+        if (zech == ZechInfinity) {
+            return 0;
+        }
+        return Antilog_[Reduce(la + zech)];
+    }
+
+    auto Mul(ui64 a, ui64 b) const -> ui64 {
+        if (a == 0 || b == 0) {
+            return 0;
+        }
+        return Antilog_[Reduce(static_cast<ui64>(Log_[a]) + Log_[b])];
+    }
+
+    auto Div(ui64 a, ui64 b) const -> ui64 {
+        if (b == 0) {
+            throw std::invalid_argument("Division by zero in Galua field");
+        }
+        if (a == 0) {
+            return 0;
+        }
+        return Antilog_[Reduce(static_cast<ui64>(Log_[a]) + (Q_ - 1) - Log_[b])];
+    }
+
+    auto Inverse(ui64 a) const -> ui64 {
+        return Div(1, a);
+    }
+
+    auto Pow(ui64 a, ui64 e) const -> ui64 {
+        if (a == 0) {
+            return e == 0 ? 1 : 0;
+        }
+        return Antilog_[(static_cast<ui64>(Log_[a]) * (e % (Q_ - 1))) % (Q_ - 1)];
+    }
+
+private:
+    TGaluaLogTable(ui64 p, ui64 n)
+        : P_{p}
+        , N_{n}
+        , Q_{FieldSize(p, n)}
+        , Generator_{0}
+        , Log_(Q_, 0)
+        , Antilog_(Q_ - 1, 0)
+        , Zech_(Q_ - 1, ZechInfinity)
+    {}
+
+    auto Reduce(ui64 e) const -> ui64 {
+        return e >= Q_ - 1 ? e - (Q_ - 1) : e;
+    }
+
+    auto Fill(const TPolynomial<i64>& base) -> bool {
+        auto modulus = MonicModulus(base);
+        if (modulus.empty()) {
+            return false;
+        }
+
+        // Candidates are screened by a few powers, tables are filled just once.
+        // Every nonzero a of a field has a^(q - 1) = 1, so the first candidate
+        // failing that proves the base reducible without trying the rest
+        auto orderFactors = primeFactors(Q_ - 1);
+        for (ui64 candidate {1}; candidate < Q_; candidate++) {
+            auto g = ToDigits(candidate);
+            if (ToRank(PowMod(g, Q_ - 1, modulus)) != 1) {
+                return false;
+            }
+            if (IsGenerator(g, modulus, orderFactors)) {
+                Generator_ = candidate;
+                break;
+            }
+        }
+        if (Generator_ == 0 || !TryGenerator(Generator_, modulus)) {
+            return false;
+        }
+
+        for (ui64 k {0}; k < Q_ - 1; k++) {
+            ui64 a = Antilog_[k];
+            ui64 onePlusA = a - a % P_ + (a % P_ + 1) % P_;
+            Zech_[k] = onePlusA == 0 ? ZechInfinity : Log_[onePlusA];
+        }
+        return true;
+    }
+
+    // Given a^(q - 1) = 1, a^((q - 1) / r) != 1 for every prime r dividing
+    // q - 1 means a has order q - 1 and all nonzero elements are its powers
+    auto IsGenerator(const std::vector<ui64>& g, const std::vector<ui64>& modulus, const std::vector<ui64>& orderFactors) const -> bool {
+        for (ui64 r : orderFactors) {
+            if (ToRank(PowMod(g, (Q_ - 1) / r, modulus)) == 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto PowMod(std::vector<ui64> a, ui64 e, const std::vector<ui64>& modulus) const -> std::vector<ui64> {
+        std::vector<ui64> result = ToDigits(1);
+        for (; e; e >>= 1) {
+            if (e & 1) result = MulMod(result, a, modulus);
+            if (e > 1) a = MulMod(a, a, modulus);
+        }
+        return result;
+    }
+
+    auto TryGenerator(ui64 candidate, const std::vector<ui64>& modulus) -> bool {
+        std::vector<ui64> g = ToDigits(candidate), current (N_, 0);
+        current[0] = 1;
+
+        for (ui64 k {0}; k < Q_ - 1; k++) {
+            ui64 rank = ToRank(current);
+            if (k != 0 && rank == 1) {
+                return false;
+            }
+            Antilog_[k] = static_cast<ui32>(rank);
+            Log_[rank] = static_cast<ui32>(k);
+            current = MulMod(current, g, modulus);
+        }
+        return ToRank(current) == 1;
+    }
+
+    auto MonicModulus(const TPolynomial<i64>& base) const -> std::vector<ui64> {
+        std::vector<ui64> modulus (N_ + 1);
+        for (ui64 i {0}; i <= N_; i++) {
+            i64 c = base[i] % static_cast<i64>(P_);
+            modulus[i] = static_cast<ui64>(c < 0 ? c + static_cast<i64>(P_) : c);
+        }
+        if (modulus[N_] == 0) {
+            return {};
+        }
+
+        ui64 leadInverse = modInverse(modulus[N_], P_);
+        for (auto& c : modulus) {
+            c = c * leadInverse % P_;
+        }
+        return modulus;
+    }
+
+    auto MulMod(const std::vector<ui64>& a, const std::vector<ui64>& b, const std::vector<ui64>& modulus) const -> std::vector<ui64> {
+        std::vector<ui64> product (2 * N_ - 1, 0);
+        for (ui64 i {0}; i < N_; i++) {
+            if (a[i] == 0) continue;
+            for (ui64 j {0}; j < N_; j++) {
+                product[i + j] = (product[i + j] + a[i] * b[j]) % P_;
+            }
+        }
+
+        for (ui64 k {2 * N_ - 2}; k >= N_; k--) {
+            if (ui64 c = product[k]; c) {
+                for (ui64 j {0}; j < N_; j++) {
+                    product[k - N_ + j] = (product[k - N_ + j] + (P_ - c) * modulus[j]) % P_;
+                }
+            }
+        }
+
+        product.resize(N_);
+        return product;
+    }
+
+    auto ToDigits(ui64 rank) const -> std::vector<ui64> {
+        std::vector<ui64> digits (N_, 0);
+        for (ui64 i {0}; i < N_; i++, rank /= P_) {
+            digits[i] = rank % P_;
+        }
+        return digits;
+    }
+
+    auto ToRank(const std::vector<ui64>& digits) const -> ui64 {
+        ui64 rank {0};
+        for (ui64 i {N_}; i > 0; i--) {
+            rank = rank * P_ + digits[i - 1];
+        }
+        return rank;
+    }
+
+private:
+    const ui64 P_;
+    const ui64 N_;
+    const ui64 Q_;
+
+    ui64 Generator_;
+
+    std::vector<ui32> Log_;
+    std::vector<ui32> Antilog_;
+    std::vector<ui32> Zech_;
+};
+
+} // namespace kimp::math
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <math/num.hpp>
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+
+namespace kimp::math {
+
+// Arithmetic modulo any n >= 1 below 2^64 on values in [0, n) with Barrett
+// reduction: x mod n = x - floor(x * mu / 2^k) * n, mu = floor((2^k - 1) / n)
+// is computed once per modulus. Products are taken in 128 bits, so they
+// never overflow; moduli below 2^32 keep all the work in 64 bits (k = 64),
+// larger ones use k = 128
+class TBarrett {
+public:
+    constexpr TBarrett(ui64 n)
+        : N_{n}
+        , Mu_{n == 0 ? 0 : IsNarrow(n) ? ~ui64 {0} / n : ~ui128 {0} / n}
+    {
+        if (n == 0) {
+            throw std::invalid_argument("Unable to reduce modulo zero");
+        }
+    }
+
+    constexpr auto GetN() const -> ui64 {
+        return N_;
+    }
+
+    // Any x below max(n^2, 2^64), a product of two residues plus a residue fits
+    constexpr auto Reduce(ui128 x) const -> ui64 {
+        if (IsNarrow(N_)) {
+            ui64 x64 = static_cast<ui64>(x);
+            ui64 q = static_cast<ui64>((static_cast<ui128>(x64) * static_cast<ui64>(Mu_)) >> 64);
+            ui64 r = x64 - q * N_;
+            while (r >= N_) r -= N_;
+            return r;
+        }
+
+        ui128 q = MulHigh(x, Mu_);
+        ui128 r = x - q * N_;
+        while (r >= N_) r -= N_;
+        return static_cast<ui64>(r);
+    }
+
+    constexpr auto Mul(ui64 a, ui64 b) const -> ui64 {
+        return Reduce(static_cast<ui128>(a) * b);
+    }
+
+    // a * b + c, one reduction for multiply-accumulate loops
+    constexpr auto MulAdd(ui64 a, ui64 b, ui64 c) const -> ui64 {
+        return Reduce(static_cast<ui128>(a) * b + c);
+    }
+
+    constexpr auto Add(ui64 a, ui64 b) const -> ui64 {
+        return a >= N_ - b ? a - (N_ - b) : a + b;
+    }
+
+    constexpr auto Sub(ui64 a, ui64 b) const -> ui64 {
+        return a >= b ? a - b : a + (N_ - b);
+    }
+
+    constexpr auto Neg(ui64 a) const -> ui64 {
+        return a == 0 ? 0 : N_ - a;
+    }
+
+    constexpr auto Pow(ui64 a, ui64 e) const -> ui64 {
+        ui64 result = N_ == 1 ? 0 : 1;
+        for (; e; e >>= 1, a = Mul(a, a)) {
+            if (e & 1) result = Mul(result, a);
+        }
+        return result;
+    }
+
+    constexpr auto operator==(const TBarrett& other) const -> bool {
+        return N_ == other.N_;
+    }
+
+private:
+    // x * n and x itself fit into 64 bits for every x below n^2
+    static constexpr auto IsNarrow(ui64 n) -> bool {
+        return n <= (ui64 {1} << 32);
+    }
+
+    // Upper 128 bits of the 256-bit product
+    static constexpr auto MulHigh(ui128 a, ui128 b) -> ui128 {
+        ui64 a0 = static_cast<ui64>(a), a1 = static_cast<ui64>(a >> 64);
+        ui64 b0 = static_cast<ui64>(b), b1 = static_cast<ui64>(b >> 64);
+
+        ui128 low = static_cast<ui128>(a0) * b0;
+        ui128 cross0 = static_cast<ui128>(a0) * b1;
+        ui128 cross1 = static_cast<ui128>(a1) * b0;
+        ui128 middle = (low >> 64) + static_cast<ui64>(cross0) + static_cast<ui64>(cross1);
+        return static_cast<ui128>(a1) * b1 + (cross0 >> 64) + (cross1 >> 64) + (middle >> 64);
+    }
+
+private:
+    ui64 N_;
+    ui128 Mu_;
+};
+
+// Arithmetic modulo an odd p < 2^62 in Montgomery form with R = 2^64
+class TMontgomery {
+public:
+    constexpr TMontgomery(ui64 p)
+        : P_{p}
+        , PInverse_{Inverse(p)}
+        , R2_{static_cast<ui64>((static_cast<ui128>(-p % p) << 64) % p)}
+    {}
+
+    constexpr auto GetP() const -> ui64 {
+        return P_;
+    }
+
+    constexpr auto To(ui64 a) const -> ui64 {
+        return Mul(a, R2_);
+    }
+
+    constexpr auto From(ui64 a) const -> ui64 {
+        return Reduce(a);
+    }
+
+    constexpr auto Mul(ui64 a, ui64 b) const -> ui64 {
+        return Reduce(static_cast<ui128>(a) * b);
+    }
+
+    // Branch free, butterflies take either branch at random
+    constexpr auto Add(ui64 a, ui64 b) const -> ui64 {
+        ui64 s = a + b;
+        return s - (s >= P_ ? P_ : 0);
+    }
+
+    constexpr auto Sub(ui64 a, ui64 b) const -> ui64 {
+        ui64 d = a - b;
+        return d + (a < b ? P_ : 0);
+    }
+
+    constexpr auto Pow(ui64 a, ui64 e) const -> ui64 {
+        ui64 result = To(1);
+        for (; e; e >>= 1, a = Mul(a, a)) {
+            if (e & 1) result = Mul(result, a);
+        }
+        return result;
+    }
+
+private:
+    // p^-1 mod 2^64 by Newton's iteration, each step doubles correct bits
+    static constexpr auto Inverse(ui64 p) -> ui64 {
+        ui64 inverse {p};
+        for (int i {0}; i < 5; i++) {
+            inverse *= 2 - p * inverse;
+        }
+        return inverse;
+    }
+
+    // t R^-1 mod p = (t - m p) / R with m = t p^-1 mod R, the low halves cancel
+    constexpr auto Reduce(ui128 t) const -> ui64 {
+        ui64 m = static_cast<ui64>(t) * PInverse_;
+        ui64 high = static_cast<ui64>(t >> 64), mp = static_cast<ui64>((static_cast<ui128>(m) * P_) >> 64);
+        return high - mp + (high < mp ? P_ : 0);
+    }
+
+private:
+    ui64 P_;
+    ui64 PInverse_;
+    ui64 R2_;
+};
+
+} // namespace kimp::math
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <math/modular.hpp>
+#include <math/num.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace kimp::math {
+
+// Operand lengths (coefficient counts of the shorter factor) from which
+// polynomial products switch to a faster algorithm. Picked by timing
+// products of random polynomials of equal length: Karatsuba wins from a few
+// dozens of coefficients, three NTTs over 62-bit primes catch up with it only
+// at tens of thousands. Tune them per machine
+struct TPolynomialMulThresholds {
+    std::size_t Karatsuba {32};
+    std::size_t Ntt {1 << 15};
+};
+
+inline TPolynomialMulThresholds polynomialMulThresholds {};
+
+namespace NPrivate {
+
+// Products below are over coefficients listed from the lowest degree, out
+// holds a.size() + b.size() - 1 values and doesn't overlap the operands
+
+template <typename T>
+auto schoolbookMul(std::span<const T> a, std::span<const T> b, std::span<T> out) -> void {
+    std::fill(out.begin(), out.end(), T {0});
+    for (std::size_t i {0}; i < a.size(); i++) {
+        if (a[i] == 0) continue;
+        T* row = out.data() + i;
+        for (std::size_t j {0}; j < b.size(); j++) {
+            row[j] += a[i] * b[j];
+        }
+    }
+}
+
+template <typename T>
+auto karatsubaMul(std::span<const T> a, std::span<const T> b, std::span<T> out) -> void;
+
+// Splits the longer operand into pieces as long as the shorter one, so
+// Karatsuba always works with equal halves
+template <typename T>
+auto unbalancedMul(std::span<const T> a, std::span<const T> b, std::span<T> out) -> void {
+    if (a.size() < b.size()) {
+        std::swap(a, b);
+    }
+    if (b.size() < polynomialMulThresholds.Karatsuba) {
+        schoolbookMul(a, b, out);
+        return;
+    }
+    if (a.size() == b.size()) {
+        karatsubaMul(a, b, out);
+        return;
+    }
+
+    std::fill(out.begin(), out.end(), T {0});
+    std::vector<T> piece (2 * b.size() - 1);
+    for (std::size_t offset {0}; offset < a.size(); offset += b.size()) {
+        auto part = a.subspan(offset, std::min(b.size(), a.size() - offset));
+        std::span<T> product {piece.data(), part.size() + b.size() - 1};
+        unbalancedMul(part, b, product);
+        for (std::size_t i {0}; i < product.size(); i++) {
+            out[offset + i] += product[i];
+        }
+    }
+}
+
+// a = a0 + x^m a1, b = b0 + x^m b1:
+// ab = a0 b0 + x^m ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) + x^2m a1 b1
+template <typename T>
+auto karatsubaMul(std::span<const T> a, std::span<const T> b, std::span<T> out) -> void {
+    std::size_t n = a.size();
+    if (n < polynomialMulThresholds.Karatsuba) {
+        schoolbookMul(a, b, out);
+        return;
+    }
+
+    std::size_t m = n / 2, h = n - m;
+    auto a0 = a.first(m), a1 = a.subspan(m), b0 = b.first(m), b1 = b.subspan(m);
+
+    std::vector<T> sums (2 * h), middle (2 * h - 1);
+    std::span<T> sumA {sums.data(), h}, sumB {sums.data() + h, h};
+    for (std::size_t i {0}; i < h; i++) {
+        sumA[i] = a1[i] + (i < m ? a0[i] : T {0});
+        sumB[i] = b1[i] + (i < m ? b0[i] : T {0});
+    }
+
+    std::span<T> low = out.first(2 * m - 1), high = out.subspan(2 * m);
+    out[2 * m - 1] = T {0};
+    karatsubaMul<T>(a0, b0, low);
+    karatsubaMul<T>(a1, b1, high);
+    karatsubaMul<T>(sumA, sumB, middle);
+
+    for (std::size_t i {0}; i < low.size(); i++) {
+        middle[i] -= low[i];
+    }
+    for (std::size_t i {0}; i < high.size(); i++) {
+        middle[i] -= high[i];
+    }
+    for (std::size_t i {0}; i < middle.size(); i++) {
+        out[m + i] += middle[i];
+    }
+}
+
+struct TNttPrime {
+    ui64 P;
+    ui64 Root;
+    // Largest power of two dividing p - 1, it bounds the transform length
+    ui64 TwoAdicity;
+};
+
+// p = c * 2^k + 1 below 2^62 with a primitive root. Their product exceeds
+// 2^183, twice any coefficient of a product of 64-bit polynomials shorter
+// than 2^56, so integer products are recovered exactly
+inline constexpr std::array<TNttPrime, 3> NttPrimes {{
+    {4179340454199820289ull, 3, 57}
+    , {2485986994308513793ull, 5, 55}
+    , {1945555039024054273ull, 5, 56}
+}};
+
+// In place cyclic transform of Montgomery form values, size is a power of two
+inline auto ntt(std::vector<ui64>& values, const TMontgomery& mont, ui64 root, bool inverse) -> void {
+    std::size_t n = values.size();
+    for (std::size_t i {1}, j {0}; i < n; i++) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(values[i], values[j]);
+        }
+    }
+
+    ui64 p = mont.GetP();
+    for (std::size_t length {2}; length <= n; length <<= 1) {
+        ui64 w = mont.Pow(mont.To(root), (p - 1) / length);
+        if (inverse) {
+            w = mont.Pow(w, p - 2);
+        }
+        std::vector<ui64> twiddles (length / 2);
+        twiddles[0] = mont.To(1);
+        for (std::size_t k {1}; k < twiddles.size(); k++) {
+            twiddles[k] = mont.Mul(twiddles[k - 1], w);
+        }
+        for (std::size_t start {0}; start < n; start += length) {
+            for (std::size_t k {0}; k < length / 2; k++) {
+                ui64 u = values[start + k];
+                ui64 v = mont.Mul(values[start + k + length / 2], twiddles[k]);
+                values[start + k] = mont.Add(u, v);
+                values[start + k + length / 2] = mont.Sub(u, v);
+            }
+        }
+    }
+
+    if (inverse) {
+        ui64 scale = mont.Pow(mont.To(n % p), p - 2);
+        for (auto& v : values) {
+            v = mont.Mul(v, scale);
+        }
+    }
+}
+
+template <typename T>
+auto residue(T value, ui64 p) -> ui64 {
+    if constexpr (isSignedIntegral<T>) {
+        if (value < 0) {
+            ui64 r = (ui64 {0} - static_cast<ui64>(static_cast<i64>(value))) % p;
+            return r ? p - r : 0;
+        }
+    }
+    return static_cast<ui64>(value) % p;
+}
+
+// Cyclic convolutions of a and b of the given power of two size modulo every
+// NTT prime, plain (not Montgomery form) residues
+template <typename T> requires isIntegral<T>
+auto nttConvolve(std::span<const T> a, std::span<const T> b, std::size_t size) -> std::array<std::vector<ui64>, NttPrimes.size()> {
+    std::array<std::vector<ui64>, NttPrimes.size()> residues;
+    for (std::size_t k {0}; k < NttPrimes.size(); k++) {
+        TMontgomery mont {NttPrimes[k].P};
+        std::vector<ui64> fa (size, 0), fb (size, 0);
+        for (std::size_t i {0}; i < a.size(); i++) {
+            fa[i] = mont.To(residue(a[i], mont.GetP()));
+        }
+        for (std::size_t i {0}; i < b.size(); i++) {
+            fb[i] = mont.To(residue(b[i], mont.GetP()));
+        }
+
+        ntt(fa, mont, NttPrimes[k].Root, false);
+        ntt(fb, mont, NttPrimes[k].Root, false);
+        for (std::size_t i {0}; i < size; i++) {
+            fa[i] = mont.Mul(fa[i], fb[i]);
+        }
+        ntt(fa, mont, NttPrimes[k].Root, true);
+
+        for (auto& v : fa) {
+            v = mont.From(v);
+        }
+        residues[k] = std::move(fa);
+    }
+    return residues;
+}
+
+// Garner's mixed radix digits of x in [0, p0 p1 p2) from its residues:
+// x = v0 + v1 p0 + v2 p0 p1
+class TGarner {
+public:
+    TGarner()
+        : M1_{NttPrimes[1].P}
+        , M2_{NttPrimes[2].P}
+    {
+        ui64 p0 = NttPrimes[0].P, p1 = NttPrimes[1].P, p2 = NttPrimes[2].P;
+        P0InverseMod1_ = M1_.Pow(M1_.To(p0 % p1), p1 - 2);
+        P0Mod2_ = M2_.To(p0 % p2);
+        P0P1InverseMod2_ = M2_.Pow(M2_.Mul(P0Mod2_, M2_.To(p1 % p2)), p2 - 2);
+    }
+
+    auto Digits(ui64 r0, ui64 r1, ui64 r2) const -> std::array<ui64, 3> {
+        ui64 p1 = NttPrimes[1].P, p2 = NttPrimes[2].P;
+        ui64 v1 = M1_.From(M1_.Mul(M1_.To(M1_.Sub(r1, r0 % p1)), P0InverseMod1_));
+        ui64 v2 = M2_.Sub(M2_.To(r2 % p2), M2_.To(r0 % p2));
+        v2 = M2_.Sub(v2, M2_.Mul(M2_.To(v1 % p2), P0Mod2_));
+        return {r0, v1, M2_.From(M2_.Mul(v2, P0P1InverseMod2_))};
+    }
+
+private:
+    TMontgomery M1_;
+    TMontgomery M2_;
+    // Montgomery form constants
+    ui64 P0InverseMod1_;
+    ui64 P0Mod2_;
+    ui64 P0P1InverseMod2_;
+};
+
+// Exact product through NTTs modulo NttPrimes glued by Garner's algorithm,
+// coefficients are then wrapped to T just like schoolbook overflow does
+template <typename T> requires isIntegral<T>
+auto nttMul(std::span<const T> a, std::span<const T> b, std::span<T> out) -> void {
+    std::size_t size {1};
+    while (size < out.size()) {
+        size <<= 1;
+    }
+    auto residues = nttConvolve(a, b, size);
+
+    // x lies in [0, p0 p1 p2), the upper half is negative
+    ui64 p0 = NttPrimes[0].P, p1 = NttPrimes[1].P, p2 = NttPrimes[2].P;
+    std::array<ui64, 3> half {(p0 - 1) / 2, (p1 - 1) / 2, (p2 - 1) / 2};
+    ui64 modulusWrapped = p0 * p1 * p2;
+    TGarner garner;
+    for (std::size_t i {0}; i < out.size(); i++) {
+        auto digits = garner.Digits(residues[0][i], residues[1][i], residues[2][i]);
+        ui64 x = digits[0] + digits[1] * p0 + digits[2] * p0 * p1;
+        if (std::lexicographical_compare(half.rbegin(), half.rend(), digits.rbegin(), digits.rend())) {
+            x -= modulusWrapped;
+        }
+        out[i] = static_cast<T>(x);
+    }
+}
+
+// Product of residues modulo mod.GetN() through the same transforms, exact
+// while the operands are shorter than 2^56
+inline auto nttMulMod(std::span<const ui64> a, std::span<const ui64> b, std::span<ui64> out, const TBarrett& mod) -> void {
+    std::size_t size {1};
+    while (size < out.size()) {
+        size <<= 1;
+    }
+    auto residues = nttConvolve(a, b, size);
+
+    ui64 p0 = mod.Reduce(NttPrimes[0].P);
+    ui64 p0p1 = mod.Mul(p0, mod.Reduce(NttPrimes[1].P));
+    TGarner garner;
+    for (std::size_t i {0}; i < out.size(); i++) {
+        auto digits = garner.Digits(residues[0][i], residues[1][i], residues[2][i]);
+        ui64 x = mod.MulAdd(mod.Reduce(digits[2]), p0p1, mod.Reduce(digits[0]));
+        out[i] = mod.MulAdd(mod.Reduce(digits[1]), p0, x);
+    }
+}
+
+// Picks the algorithm by the shorter operand length
+template <typename T>
+auto polynomialMul(std::span<const T> a, std::span<const T> b, std::span<T> out) -> void {
+    std::size_t shorter = std::min(a.size(), b.size());
+    if constexpr (isIntegral<T>) {
+        if (shorter >= polynomialMulThresholds.Ntt) {
+            nttMul(a, b, out);
+            return;
+        }
+    }
+    if (shorter >= polynomialMulThresholds.Karatsuba) {
+        unbalancedMul(a, b, out);
+        return;
+    }
+    schoolbookMul(a, b, out);
+}
+
+} // namespace NPrivate
+
+} // namespace kimp::math
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <type_traits>
 
 namespace kimp::math {
@@ -8,8 +10,10 @@ namespace kimp::math {
 typedef std::int32_t i32;
 typedef std::int64_t i64;
 
+typedef std::uint8_t ui8;
 typedef std::uint32_t ui32;
 typedef std::uint64_t ui64;
+typedef unsigned __int128 ui128;
 
 template <typename T>
 concept isSignedIntegral = std::is_same_v<T, i32> || std::is_same_v<T, i64>;
@@ -26,9 +30,20 @@ concept isFloatingPoint = std::is_same_v<T, float> || std::is_same_v<T, double>;
 template <typename T>
 concept isNumeric = isIntegral<T> || isFloatingPoint<T>;
 
+template <typename T>
+concept isHashable = requires (const T& v) {
+    { std::hash<T> {}(v) } -> std::convertible_to<std::size_t>;
+};
+
+inline auto hashCombine(std::size_t seed, std::size_t value) -> std::size_t {
+    return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+}
+
 } // namespace kimp::math
 
 using i32 = kimp::math::i32;
 using i64 = kimp::math::i64;
+using ui8 = kimp::math::ui8;
 using ui32 = kimp::math::ui32;
 using ui64 = kimp::math::ui64;
+using ui128 = kimp::math::ui128;
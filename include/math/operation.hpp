@@ -1,17 +1,50 @@
 #pragma once
 
 #include "math/polynomial.hpp"
+#include <math/binary.hpp>
 #include <math/deduction.hpp>
+#include <math/elements.hpp>
+#include <math/logtable.hpp>
 #include <math/num.hpp>
+#include <math/packed.hpp>
+#include <math/rank.hpp>
 #include <math/set.hpp>
+#include <math/static.hpp>
+#include <utils/stats.hpp>
 #include <utils/trait.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <stdexcept>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace kimp::math {
 
+// How closure is verified when an operation can't prove it for the set
+enum class EClosureCheck {
+    Full
+    , Sampled
+};
+
+// (p, n) if the set holds every polynomial of degree below n over GF(p) exactly once
+template <typename T>
+auto completeGaluaSetParameters(const ISetPtr<TPolynomial<T>>& set) -> std::optional<std::pair<ui64, ui64>> {
+    if (auto elementSet = std::dynamic_pointer_cast<TGaluaElementSet>(set); elementSet) {
+        return std::make_pair(elementSet->GetP(), elementSet->GetN());
+    }
+    if (auto packedSet = std::dynamic_pointer_cast<TGaluaPackedSet<ui64>>(set); packedSet && packedSet->IsComplete()) {
+        return std::make_pair(packedSet->GetPacking()->GetP(), packedSet->GetPacking()->GetN());
+    }
+    return std::nullopt;
+}
+
 template <typename T>
 class IMathOperation;
 template <typename T>
@@ -20,27 +53,108 @@ using IMathOperationPtr = std::shared_ptr<IMathOperation<T>>;
 template <typename T>
 class IMathOperation {
 public:
+    // Pairs checked by EClosureCheck::Sampled, smaller sets are checked fully
+    static constexpr std::size_t ClosureSamples = 1 << 16;
+    // Below this number of pairs the check runs on the calling thread
+    static constexpr std::size_t ParallelClosureThreshold = 1 << 14;
+
     virtual auto Apply(const T&, const T&) const -> T = 0;
 
     virtual auto IsAllDeterminedFor(const ISetPtr<T>&) const -> bool = 0;
     virtual auto IsUnambiguousFor(const ISetPtr<T>&) const -> bool = 0;
-    virtual auto IsClosedFor(const ISetPtr<T>&) const -> bool = 0;
+    virtual auto IsClosedFor(const ISetPtr<T>&, EClosureCheck) const -> bool = 0;
 
     virtual ~IMathOperation() {}
 
 protected:
-    auto IsClosedForStaticSetFullCheck(const TStaticSetPtr<T>& sSet) const -> bool {
-        auto setElements = sSet->GetElements();
+    // Results are memoized per set: a full check answers any later query,
+    // a sampled one only sampled queries or a found counterexample
+    auto IsClosedForFiniteSet(const IFiniteSetPtr<T>& fSet, EClosureCheck check) const -> bool {
+        std::lock_guard lock {ClosureCacheMutex_};
+
+        std::erase_if(ClosureCache_, [] (const TClosureCacheEntry& entry) { return entry.Set.expired(); });
+        for (const auto& entry : ClosureCache_) {
+            if (entry.Set.lock() == fSet && (entry.Check == EClosureCheck::Full || !entry.Closed || check == EClosureCheck::Sampled)) {
+                return entry.Closed;
+            }
+        }
+
+        KIMP_STATS_COUNT(ClosureCheck);
+        KIMP_STATS_SCOPE("closure check");
+        bool closed = check == EClosureCheck::Full || fSet->Size() * fSet->Size() <= ClosureSamples
+            ? IsClosedForFiniteSetFullCheck(fSet)
+            : IsClosedForFiniteSetSampledCheck(fSet);
+        ClosureCache_.push_back({fSet, check, closed});
+        return closed;
+    }
+
+    auto IsClosedForFiniteSetFullCheck(const IFiniteSetPtr<T>& fSet) const -> bool {
+        auto elements = Materialize(fSet);
 
-        for (auto a : setElements) {
-            for (auto b : setElements) {
-                if (!sSet->contains(this->Apply(a, b))) {
+        return RunClosureCheck(elements.size() * elements.size(), [&] (std::size_t first, std::size_t step, const std::atomic<bool>& failed) {
+            for (std::size_t i {first}; i < elements.size() && !failed.load(std::memory_order_relaxed); i += step) {
+                for (const auto& b : elements) {
+                    if (!fSet->contains(this->Apply(elements[i], b))) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        });
+    }
+
+    auto IsClosedForFiniteSetSampledCheck(const IFiniteSetPtr<T>& fSet) const -> bool {
+        return RunClosureCheck(ClosureSamples, [&] (std::size_t first, std::size_t step, const std::atomic<bool>& failed) {
+            std::mt19937_64 rng {first};
+            std::uniform_int_distribution<std::size_t> index {0, fSet->Size() - 1};
+            for (std::size_t i {first}; i < ClosureSamples && !failed.load(std::memory_order_relaxed); i += step) {
+                if (!fSet->contains(this->Apply(fSet->At(index(rng)), fSet->At(index(rng))))) {
                     return false;
                 }
             }
+            return true;
+        });
+    }
+
+private:
+    static auto Materialize(const IFiniteSetPtr<T>& fSet) -> std::vector<T> {
+        std::vector<T> elements;
+        elements.reserve(fSet->Size());
+        for (std::size_t i {0}; i < fSet->Size(); i++) {
+            elements.push_back(fSet->At(i));
         }
-        return true;
+        return elements;
     }
+
+    // Runs worker(first, step, failed) over interleaved parts of the work on
+    // all cores, a worker returns false as soon as it finds a counterexample
+    template <typename TWorker>
+    static auto RunClosureCheck(std::size_t work, const TWorker& worker) -> bool {
+        std::size_t threads = work < ParallelClosureThreshold ? 1 : std::max(1u, std::thread::hardware_concurrency());
+        std::atomic<bool> failed {false};
+
+        std::vector<std::thread> pool;
+        for (std::size_t t {1}; t < threads; t++) {
+            pool.emplace_back([&, t] () {
+                if (!worker(t, threads, failed)) failed.store(true);
+            });
+        }
+        if (!worker(0, threads, failed)) failed.store(true);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        return !failed.load();
+    }
+
+private:
+    struct TClosureCacheEntry {
+        std::weak_ptr<IFiniteSet<T>> Set;
+        EClosureCheck Check;
+        bool Closed;
+    };
+
+    mutable std::mutex ClosureCacheMutex_;
+    mutable std::vector<TClosureCacheEntry> ClosureCache_;
 };
 
 template <typename T>
@@ -54,6 +168,7 @@ public:
     TSumOperation() {}
 
     virtual T Apply(const T& a, const T&b) const override {
+        KIMP_STATS_COUNT(OperationApply);
         return a + b;
     }
 
@@ -65,12 +180,12 @@ public:
         return true;
     }
 
-    virtual bool IsClosedFor(const ISetPtr<T>& set) const override {
+    virtual bool IsClosedFor(const ISetPtr<T>& set, EClosureCheck check) const override {
         if (TIntegerSetPtr iSet = std::dynamic_pointer_cast<TIntegerSet>(set); iSet) {
             return true;
         }
-        if (TStaticSetPtr<T> sSet = std::dynamic_pointer_cast<TStaticSet<T>>(set); sSet) {
-            return this->IsClosedForStaticSetFullCheck(sSet);
+        if (IFiniteSetPtr<T> fSet = std::dynamic_pointer_cast<IFiniteSet<T>>(set); fSet) {
+            return this->IsClosedForFiniteSet(fSet, check);
         }
         throw std::invalid_argument("Behaviour is undefined for given set type");
     }
@@ -86,13 +201,37 @@ using TGaluaSumOperationPtr = std::shared_ptr<TGaluaSumOperation<T>>;
 template <typename T>
 class TGaluaSumOperation : public IMathOperation<TPolynomial<T>> {
 public:
-    TGaluaSumOperation(T n) : N_{n} {
+    TGaluaSumOperation(
+        T n
+        , const TGaluaLogTablePtr& logTable = nullptr
+        , const TGaluaPackingPtr<ui64>& packing = nullptr
+        , const TGaluaStaticTablesPtr& staticTables = nullptr
+    )
+        : N_{n}
+        , LogTable_{logTable}
+        , Packing_{packing}
+        , StaticTables_{staticTables}
+    {
         if (N_ == 0) {
             throw std::invalid_argument("Unable to sum polynomials with mod by zero");
         }
     }
 
     virtual TPolynomial<T> Apply(const TPolynomial<T>& a, const TPolynomial<T>& b) const override {
+        KIMP_STATS_COUNT(OperationApply);
+        if (StaticTables_) {
+            if (ui64 ra = polynomialToRank(a, N_), rb = polynomialToRank(b, N_); ra < StaticTables_->Size() && rb < StaticTables_->Size()) {
+                return rankToPolynomial<T>(StaticTables_->Sum(ra, rb), N_);
+            }
+        }
+        if (LogTable_) {
+            if (ui64 ra = polynomialToRank(a, N_), rb = polynomialToRank(b, N_); ra < LogTable_->Size() && rb < LogTable_->Size()) {
+                return rankToPolynomial<T>(LogTable_->Sum(ra, rb), N_);
+            }
+        }
+        if (Packing_ && a.Degree() < Packing_->GetN() && b.Degree() < Packing_->GetN()) {
+            return Packing_->template Unpack<T>(Packing_->Sum(Packing_->Pack(a), Packing_->Pack(b)));
+        }
         return (a + b) % N_;
     }
 
@@ -104,9 +243,13 @@ public:
         return true;
     }
 
-    virtual bool IsClosedFor(const ISetPtr<TPolynomial<T>>& set) const override {
-        if (TStaticSetPtr<TPolynomial<T>> sSet = std::dynamic_pointer_cast<TStaticSet<TPolynomial<T>>>(set); sSet) {
-            return this->IsClosedForStaticSetFullCheck(sSet);
+    virtual bool IsClosedFor(const ISetPtr<TPolynomial<T>>& set, EClosureCheck check) const override {
+        // Sum of polynomials of degree below n with coefficients reduced mod p stays such
+        if (auto parameters = completeGaluaSetParameters(set); parameters && parameters->first == static_cast<ui64>(N_)) {
+            return true;
+        }
+        if (IFiniteSetPtr<TPolynomial<T>> fSet = std::dynamic_pointer_cast<IFiniteSet<TPolynomial<T>>>(set); fSet) {
+            return this->IsClosedForFiniteSet(fSet, check);
         }
         throw std::invalid_argument("Behaviour is undefined for given set type");
     }
@@ -115,6 +258,9 @@ public:
 
 private:
     const T N_;
+    const TGaluaLogTablePtr LogTable_;
+    const TGaluaPackingPtr<ui64> Packing_;
+    const TGaluaStaticTablesPtr StaticTables_;
 };
 
 template <typename T>
@@ -128,6 +274,7 @@ public:
     TMulOperation() {}
 
     virtual T Apply(const T& a, const T&b) const override {
+        KIMP_STATS_COUNT(OperationApply);
         return a * b;
     }
 
@@ -139,12 +286,12 @@ public:
         return true;
     }
 
-    virtual bool IsClosedFor(const ISetPtr<T>& set) const override {
+    virtual bool IsClosedFor(const ISetPtr<T>& set, EClosureCheck check) const override {
         if (TIntegerSetPtr iSet = std::dynamic_pointer_cast<TIntegerSet>(set); iSet) {
             return true;
         }
-        if (TStaticSetPtr<T> sSet = std::dynamic_pointer_cast<TStaticSet<T>>(set); sSet) {
-            return this->IsClosedForStaticSetFullCheck(sSet);
+        if (IFiniteSetPtr<T> fSet = std::dynamic_pointer_cast<IFiniteSet<T>>(set); fSet) {
+            return this->IsClosedForFiniteSet(fSet, check);
         }
         throw std::invalid_argument("Behaviour is undefined for given set type");
     }
@@ -160,13 +307,44 @@ using TGaluaMulOperationPtr = std::shared_ptr<TGaluaMulOperation<T>>;
 template <typename T>
 class TGaluaMulOperation : public IMathOperation<TPolynomial<T>> {
 public:
-    TGaluaMulOperation(const TPolynomialPtr<i64>& p, T n) : P_{p}, N_{n} {
+    TGaluaMulOperation(
+        const TPolynomialPtr<i64>& p
+        , T n
+        , const TGaluaLogTablePtr& logTable = nullptr
+        , const TGaluaPackingPtr<ui64>& packing = nullptr
+        , const TGaluaBinaryArithmeticPtr& binary = nullptr
+        , const TGaluaStaticTablesPtr& staticTables = nullptr
+    )
+        : P_{p}
+        , N_{n}
+        , LogTable_{logTable}
+        , Packing_{packing}
+        , Binary_{binary}
+        , StaticTables_{staticTables}
+    {
         if (N_ == 0) {
             throw std::invalid_argument("Unable to sum polynomials with mod by zero");
         }
     }
 
     virtual TPolynomial<T> Apply(const TPolynomial<T>& a, const TPolynomial<T>& b) const override {
+        KIMP_STATS_COUNT(OperationApply);
+        if (StaticTables_) {
+            if (ui64 ra = polynomialToRank(a, N_), rb = polynomialToRank(b, N_); ra < StaticTables_->Size() && rb < StaticTables_->Size()) {
+                return rankToPolynomial<T>(StaticTables_->Mul(ra, rb), N_);
+            }
+        }
+        if (LogTable_) {
+            if (ui64 ra = polynomialToRank(a, N_), rb = polynomialToRank(b, N_); ra < LogTable_->Size() && rb < LogTable_->Size()) {
+                return rankToPolynomial<T>(LogTable_->Mul(ra, rb), N_);
+            }
+        }
+        if (Binary_ && a.Degree() < Binary_->GetN() && b.Degree() < Binary_->GetN()) {
+            return Binary_->template Unpack<T>(Binary_->Mul(Binary_->Pack(a), Binary_->Pack(b)));
+        }
+        if (Packing_ && a.Degree() < Packing_->GetN() && b.Degree() < Packing_->GetN()) {
+            return Packing_->template Unpack<T>(Packing_->Mul(Packing_->Pack(a), Packing_->Pack(b)));
+        }
         return (((a * b) * (N_ + 1)) % *P_) % N_;
     }
 
@@ -178,18 +356,32 @@ public:
         return true;
     }
 
-    virtual bool IsClosedFor(const ISetPtr<TPolynomial<T>>& set) const override {
-        if (TStaticSetPtr<TPolynomial<T>> sSet = std::dynamic_pointer_cast<TStaticSet<TPolynomial<T>>>(set); sSet) {
-            return this->IsClosedForStaticSetFullCheck(sSet);
+    virtual bool IsClosedFor(const ISetPtr<TPolynomial<T>>& set, EClosureCheck check) const override {
+        // Product is reduced modulo the base of degree n and mod p, so it's one of all such residues.
+        // The polynomial fallback divides by the leading coefficient as integers, so a non-monic
+        // base may leave products of degree n or more and closure is checked on elements instead
+        if (auto parameters = completeGaluaSetParameters(set); parameters && parameters->first == static_cast<ui64>(N_) && parameters->second == P_->Degree() && (*P_)[P_->Degree()] == 1) {
+            return true;
+        }
+        if (IFiniteSetPtr<TPolynomial<T>> fSet = std::dynamic_pointer_cast<IFiniteSet<TPolynomial<T>>>(set); fSet) {
+            return this->IsClosedForFiniteSet(fSet, check);
         }
         throw std::invalid_argument("Behaviour is undefined for given set type");
     }
 
     virtual ~TGaluaMulOperation() {}
 
+    auto GetLogTable() const -> TGaluaLogTablePtr {
+        return LogTable_;
+    }
+
 private:
     const TPolynomialPtr<i64> P_;
     const T N_;
+    const TGaluaLogTablePtr LogTable_;
+    const TGaluaPackingPtr<ui64> Packing_;
+    const TGaluaBinaryArithmeticPtr Binary_;
+    const TGaluaStaticTablesPtr StaticTables_;
 };
 
 } // namespace kimp::math
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <math/gcd.hpp>
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+#include <math/set.hpp>
+#include <utils/stats.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace kimp::math {
+
+template <typename T>
+concept isPackedWord = std::is_same_v<T, ui64> || std::is_same_v<T, ui128>;
+
+template <typename TWord> requires isPackedWord<TWord>
+class TGaluaPacking;
+template <typename TWord = ui64> requires isPackedWord<TWord>
+using TGaluaPackingPtr = std::shared_ptr<TGaluaPacking<TWord>>;
+
+// GF(p^n) element packed into a machine word: coefficient of x^k lives in
+// the k-th lane of W = bits(p - 1) + 2 bits, the top bit of every lane is a
+// guard for the carry-free (SWAR) modular addition. Packed words compare in
+// the same order as element ranks
+template <typename TWord> requires isPackedWord<TWord>
+class TGaluaPacking {
+public:
+    static constexpr ui64 WordBits = sizeof(TWord) * 8;
+    static constexpr ui64 MaxLanes = WordBits / 3;
+
+    static auto LaneBits(ui64 p) -> ui64 {
+        ui64 bits {0};
+        for (ui64 v {p - 1}; v; v >>= 1) {
+            bits++;
+        }
+        return bits + 2;
+    }
+
+    static auto Fits(ui64 p, ui64 n) -> bool {
+        return p >= 2 && p < (ui64 {1} << 31) && n >= 1 && n * LaneBits(p) <= WordBits;
+    }
+
+    TGaluaPacking(const TPolynomial<i64>& base, ui64 p, ui64 n)
+        : P_{p}
+        , N_{n}
+        , W_{LaneBits(p)}
+    {
+        if (!Fits(p, n)) {
+            throw std::invalid_argument(fmt::format("Unable to pack F(p = {}, n = {}) elements into {}-bit words", p, n, WordBits));
+        }
+        LaneMask_ = (TWord {1} << (W_ - 1)) - 1;
+        if (base.Degree() != n) {
+            throw std::invalid_argument("Base polynomial degree should be equal to n");
+        }
+
+        for (ui64 k {0}; k < N_; k++) {
+            Guard_ |= TWord {1} << (k * W_ + W_ - 1);
+            Bias_ |= static_cast<TWord>((ui64 {1} << (W_ - 1)) - P_) << (k * W_);
+            PLanes_ |= static_cast<TWord>(P_) << (k * W_);
+        }
+
+        for (ui64 i {0}; i <= N_; i++) {
+            Modulus_[i] = Reduce(base[i]);
+        }
+        if (Modulus_[N_] == 0) {
+            throw std::invalid_argument("Base polynomial leading coefficient is divisible by p");
+        }
+
+        ui64 leadInverse = modInverse(Modulus_[N_], P_);
+        for (ui64 i {0}; i <= N_; i++) {
+            Modulus_[i] = Modulus_[i] * leadInverse % P_;
+        }
+    }
+
+    auto Lane(TWord a, ui64 k) const -> ui64 {
+        return static_cast<ui64>((a >> (k * W_)) & LaneMask_);
+    }
+
+    template <typename T> requires isIntegral<T>
+    auto Pack(const TPolynomial<T>& p) const -> TWord {
+        TWord result {0};
+        for (ui64 k {0}; k <= p.Degree(); k++) {
+            ui64 coef = Reduce(p[k]);
+            if (coef && k >= N_) {
+                throw std::invalid_argument(fmt::format("Polynomial {} doesn't belong to the field", p.ToString()));
+            }
+            if (coef) {
+                result |= static_cast<TWord>(coef) << (k * W_);
+            }
+        }
+        return result;
+    }
+
+    template <typename T = i64> requires isIntegral<T>
+    auto Unpack(TWord a) const -> TPolynomial<T> {
+        std::array<T, MaxLanes> coefficients;
+        std::size_t size {0};
+        for (ui64 k {N_}; k > 0; k--) {
+            ui64 coef = Lane(a, k - 1);
+            if (coef || size) {
+                coefficients[size++] = static_cast<T>(coef);
+            }
+        }
+        if (size == 0) {
+            return TPolynomial<T>::template zero<T>();
+        }
+        return TPolynomial<T> {std::span<const T> {coefficients.data(), size}};
+    }
+
+    auto ToRank(TWord a) const -> ui64 {
+        ui64 rank {0};
+        for (ui64 k {N_}; k > 0; k--) {
+            rank = rank * P_ + Lane(a, k - 1);
+        }
+        return rank;
+    }
+
+    auto FromRank(ui64 rank) const -> TWord {
+        TWord result {0};
+        for (ui64 k {0}; k < N_ && rank; k++, rank /= P_) {
+            result |= static_cast<TWord>(rank % P_) << (k * W_);
+        }
+        return result;
+    }
+
+    auto Sum(TWord a, TWord b) const -> TWord {
+        return Normalize(a + b);
+    }
+
+    auto Sub(TWord a, TWord b) const -> TWord {
+        return Normalize(a + (PLanes_ - b));
+    }
+
+    auto Neg(TWord a) const -> TWord {
+        return Sub(0, a);
+    }
+
+    auto Mul(TWord a, TWord b) const -> TWord {
+        std::array<ui64, 2 * MaxLanes> product {};
+        std::array<ui64, MaxLanes> lanesB {};
+
+        for (ui64 j {0}; j < N_; j++) {
+            lanesB[j] = Lane(b, j);
+        }
+        for (ui64 i {0}; i < N_; i++) {
+            if (ui64 ai = Lane(a, i); ai) {
+                for (ui64 j {0}; j < N_; j++) {
+                    product[i + j] += ai * lanesB[j];
+                }
+            }
+        }
+
+        for (ui64 k {0}; k + 1 < 2 * N_; k++) {
+            product[k] %= P_;
+        }
+        for (ui64 k {2 * N_ - 1}; k-- > N_;) {
+            if (ui64 c = product[k]; c) {
+                for (ui64 j {0}; j < N_; j++) {
+                    product[k - N_ + j] = (product[k - N_ + j] + (P_ - c) * Modulus_[j]) % P_;
+                }
+            }
+        }
+
+        TWord result {0};
+        for (ui64 k {0}; k < N_; k++) {
+            result |= static_cast<TWord>(product[k]) << (k * W_);
+        }
+        return result;
+    }
+
+    auto GetP() const -> ui64 {
+        return P_;
+    }
+
+    auto GetN() const -> ui64 {
+        return N_;
+    }
+
+    auto GetLaneBits() const -> ui64 {
+        return W_;
+    }
+
+private:
+    template <typename T> requires isIntegral<T>
+    auto Reduce(T v) const -> ui64 {
+        if constexpr (isUnsignedIntegral<T>) {
+            return static_cast<ui64>(v) % P_;
+        } else {
+            i64 r = static_cast<i64>(v) % static_cast<i64>(P_);
+            return static_cast<ui64>(r < 0 ? r + static_cast<i64>(P_) : r);
+        }
+    }
+
+    auto Normalize(TWord s) const -> TWord {
+        TWord overflow = ((s + Bias_) & Guard_) >> (W_ - 1);
+        return s - overflow * static_cast<TWord>(P_);
+    }
+
+private:
+    const ui64 P_;
+    const ui64 N_;
+    const ui64 W_;
+
+    TWord LaneMask_ {0};
+    TWord Guard_ {0};
+    TWord Bias_ {0};
+    TWord PLanes_ {0};
+
+    std::array<ui64, MaxLanes + 1> Modulus_ {};
+};
+
+template <typename TWord> requires isPackedWord<TWord>
+class TGaluaPackedSet;
+template <typename TWord = ui64> requires isPackedWord<TWord>
+using TGaluaPackedSetPtr = std::shared_ptr<TGaluaPackedSet<TWord>>;
+
+template <typename TWord> requires isPackedWord<TWord>
+class TGaluaPackedSet : public IFiniteSet<TPolynomial<i64>> {
+public:
+    TGaluaPackedSet(const TGaluaPackingPtr<TWord>& packing, std::vector<TWord> elements)
+        : Packing_{packing}
+        , Elements_{std::move(elements)}
+    {
+        std::sort(Elements_.begin(), Elements_.end());
+        Complete_ = CheckComplete();
+    }
+
+    virtual bool contains(const TPolynomial<i64>& e) const override {
+        KIMP_STATS_COUNT(ContainsProbe);
+        if (e.Degree() >= Packing_->GetN() || (e.Degree() && e[e.Degree()] == 0)) {
+            return false;
+        }
+
+        TWord packed {0};
+        for (ui64 k {0}; k <= e.Degree(); k++) {
+            if (e[k] < 0 || static_cast<ui64>(e[k]) >= Packing_->GetP()) {
+                return false;
+            }
+            packed |= static_cast<TWord>(e[k]) << (k * Packing_->GetLaneBits());
+        }
+        return std::binary_search(Elements_.begin(), Elements_.end(), packed);
+    }
+
+    virtual std::size_t Size() const override {
+        return Elements_.size();
+    }
+
+    virtual TPolynomial<i64> At(std::size_t i) const override {
+        return Packing_->Unpack(Elements_.at(i));
+    }
+
+    auto GetPacked() const -> const std::vector<TWord>& {
+        return Elements_;
+    }
+
+    auto GetPacking() const -> TGaluaPackingPtr<TWord> {
+        return Packing_;
+    }
+
+    // Holds every polynomial of degree below n over GF(p) exactly once
+    auto IsComplete() const -> bool {
+        return Complete_;
+    }
+
+    auto GetElements() const -> std::vector<TPolynomial<i64>> {
+        std::vector<TPolynomial<i64>> elements;
+        elements.reserve(Elements_.size());
+        for (const auto& e : Elements_) {
+            elements.push_back(Packing_->Unpack(e));
+        }
+        return elements;
+    }
+
+    virtual ~TGaluaPackedSet() {}
+
+private:
+    auto CheckComplete() const -> bool {
+        ui64 q {1};
+        for (ui64 i {0}; i < Packing_->GetN(); i++) {
+            q *= Packing_->GetP();
+        }
+        if (Elements_.size() != q || std::adjacent_find(Elements_.begin(), Elements_.end()) != Elements_.end()) {
+            return false;
+        }
+        return std::all_of(Elements_.begin(), Elements_.end(), [&] (TWord e) {
+            return Packing_->ToRank(e) < q && Packing_->FromRank(Packing_->ToRank(e)) == e;
+        });
+    }
+
+    virtual void PrintTo(std::ostream& out) const override {
+        out << '{';
+
+        for (std::size_t i {0}; i < Elements_.size(); i++) {
+            out << Packing_->Unpack(Elements_[i]);
+            if (i + 1 != Elements_.size()) {
+                out << ", ";
+            }
+        }
+
+        out << '}';
+    }
+
+private:
+    const TGaluaPackingPtr<TWord> Packing_;
+    std::vector<TWord> Elements_;
+    bool Complete_;
+};
+
+} // namespace kimp::math
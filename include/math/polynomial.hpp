@@ -1,15 +1,21 @@
 #pragma once
 
-#include <cmath>
 #include <iostream>
+#include <math/digits.hpp>
+#include <math/modular.hpp>
+#include <math/multiply.hpp>
 #include <math/num.hpp>
+#include <utils/small_vector.hpp>
 
 #include <fmt/format.h>
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
@@ -25,23 +31,31 @@ using TPolynomialPtr = std::shared_ptr<TPolynomial<T>>;
 template <typename T> requires isNumeric<T>
 class TPolynomial {
 public:
-    TPolynomial(std::initializer_list<T> values) : Coefficients_{values} {
-        if (values.size() == 0) {
-            throw std::invalid_argument("Use TPolynomial::zero to get a polynomial that equals to 0");
-        }
+    // Coefficients of polynomials up to this degree live inside the object,
+    // so field elements and their products never touch the heap
+    static constexpr std::size_t InlineDegree = 16;
 
+    TPolynomial(std::initializer_list<T> values) : TPolynomial(std::span<const T> {values.begin(), values.size()}) {
         if (values.size() != 1 && *values.begin() == 0) {
             throw std::invalid_argument("It's incorrect to have zero coefficient up to max polynomial degree");
         }
     }
 
-    TPolynomial(const std::vector<T>& coefficients) : Coefficients_{coefficients} {
+    // Coefficients are listed from the highest degree
+    TPolynomial(std::span<const T> coefficients) {
         if (coefficients.size() == 0) {
             throw std::invalid_argument("Use TPolynomial::zero to get a polynomial that equals to 0");
         }
+        Coefficients_.assign(coefficients.rbegin(), coefficients.rend());
     }
 
-    TPolynomial(const TPolynomial<T>& p) : Coefficients_{p.Coefficients_} {}
+    TPolynomial(const std::vector<T>& coefficients) : TPolynomial(std::span<const T> {coefficients}) {}
+
+    TPolynomial(const TPolynomial<T>& p) = default;
+    TPolynomial(TPolynomial<T>&& p) noexcept = default;
+
+    auto operator=(const TPolynomial<T>& p) -> TPolynomial<T>& = default;
+    auto operator=(TPolynomial<T>&& p) noexcept -> TPolynomial<T>& = default;
 
     auto Degree() const -> std::size_t {
         return Coefficients_.size() - 1;
@@ -54,22 +68,59 @@ public:
         
         TPolynomial<T> newPolynomial {*this};
         for (std::size_t i{1}; i < p; i++) {
-            newPolynomial = newPolynomial * (*this);
+            newPolynomial *= *this;
         }
 
         return newPolynomial;
     }
 
+    // Horner's rule, integer values are computed unsigned, so they wrap
+    // around modulo 2^bits instead of overflowing
     auto Calc(T x) const -> T {
-        T result = 0;
-
-        for (std::size_t i {0}; i <= Degree(); i++) {
-            result += (operator[](i) * std::pow(x, i));
+        if constexpr (isIntegral<T>) {
+            using U = std::make_unsigned_t<T>;
+            U result = 0;
+            for (std::size_t i {Coefficients_.size()}; i > 0; i--) {
+                result = result * static_cast<U>(x) + static_cast<U>(Coefficients_[i - 1]);
+            }
+            return static_cast<T>(result);
+        } else {
+            T result = 0;
+            for (std::size_t i {Coefficients_.size()}; i > 0; i--) {
+                result = result * x + Coefficients_[i - 1];
+            }
+            return result;
         }
+    }
 
+    // Exact value at x modulo p for any p below 2^64
+    auto CalcMod(ui64 x, ui64 p) const -> ui64 requires isIntegral<T> {
+        TBarrett mod {p};
+        x %= p;
+        ui64 result {0};
+        for (std::size_t i {Coefficients_.size()}; i > 0; i--) {
+            result = mod.MulAdd(result, x, NPrivate::residue(Coefficients_[i - 1], p));
+        }
         return result;
     }
 
+    // Values at every point modulo p, see NPrivate::evaluateAll
+    auto EvaluateAll(std::span<const ui64> points, ui64 p) const -> std::vector<ui64> requires isIntegral<T> {
+        TBarrett mod {p};
+        NPrivate::TDigits digits (Coefficients_.size());
+        for (std::size_t i {0}; i < digits.size(); i++) {
+            digits[i] = NPrivate::residue(Coefficients_[i], p);
+        }
+        NPrivate::trim(digits);
+
+        std::vector<ui64> reduced (points.size()), values (points.size());
+        for (std::size_t i {0}; i < points.size(); i++) {
+            reduced[i] = points[i] % p;
+        }
+        NPrivate::evaluateAll(digits, reduced, values, mod);
+        return values;
+    }
+
     auto operator[](const std::size_t degree) const -> const T {
         if (degree > this->Degree()) {
             throw std::out_of_range(
@@ -81,82 +132,103 @@ public:
             );
         }
 
-        return Coefficients_.at(this->Degree() - degree);
+        return Coefficients_[degree];
     }
 
     template <typename U> requires isNumeric<U>
     auto operator+(const TPolynomial<U>& p) const -> TPolynomial<std::common_type_t<T, U>> {
-        auto resultDegree = std::max(this->Degree(), p.Degree());
-
-        std::vector<std::common_type_t<T, U>> newPolynomial;
-        newPolynomial.reserve(resultDegree);
-
-        for (std::size_t i {0}; i <= resultDegree; i++) {
-            newPolynomial.push_back(this->getCoefficientOrZero(resultDegree - i) + p.getCoefficientOrZero(resultDegree - i));
-        }
-
-        return TPolynomial<std::common_type_t<T, U>> {newPolynomial};
+        auto result = Cast<std::common_type_t<T, U>>();
+        result += p;
+        return result;
     }
     
     template <typename U> requires isNumeric<U>
     auto operator-(const TPolynomial<U>& p) const -> TPolynomial<std::common_type_t<T, U>> {
-        auto resultDegree = std::max(this->Degree(), p.Degree());
-
-        std::vector<std::common_type_t<T, U>> newPolynomial;
-        newPolynomial.reserve(resultDegree);
+        auto result = Cast<std::common_type_t<T, U>>();
+        result -= p;
+        return result;
+    }
+    
+    template <typename U> requires isNumeric<U>
+    auto operator*(const TPolynomial<U>& p) const -> TPolynomial<std::common_type_t<T, U>> {
+        auto result = Cast<std::common_type_t<T, U>>();
+        result *= p;
+        return result;
+    }
 
-        for (std::size_t i {0}; i <= resultDegree; i++) {
-            auto tempCoef = this->getCoefficientOrZero(resultDegree - i) - p.getCoefficientOrZero(resultDegree - i);
+    template <typename U> requires isIntegral<U>
+    auto operator%(const TPolynomial<U>& p) const -> TPolynomial<std::common_type_t<T, U>> {
+        auto result = Cast<std::common_type_t<T, U>>();
+        result %= p;
+        return result;
+    }
 
-            if (newPolynomial.size() || tempCoef != 0) {
-                newPolynomial.push_back(tempCoef);
-            }
+    template <typename U> requires isNumeric<U>
+    auto operator+=(const TPolynomial<U>& p) -> TPolynomial<T>& {
+        if (p.Coefficients_.size() > Coefficients_.size()) {
+            Coefficients_.resize(p.Coefficients_.size(), 0);
         }
+        for (std::size_t i {0}; i < p.Coefficients_.size(); i++) {
+            Coefficients_[i] += p.Coefficients_[i];
+        }
+        return *this;
+    }
 
-        if (newPolynomial.size() == 0) return TPolynomial<std::common_type_t<T, U>>::template zero<std::common_type_t<T, U>>();
-        return TPolynomial<std::common_type_t<T, U>> {newPolynomial};
+    template <typename U> requires isNumeric<U>
+    auto operator-=(const TPolynomial<U>& p) -> TPolynomial<T>& {
+        if (p.Coefficients_.size() > Coefficients_.size()) {
+            Coefficients_.resize(p.Coefficients_.size(), 0);
+        }
+        for (std::size_t i {0}; i < p.Coefficients_.size(); i++) {
+            Coefficients_[i] -= p.Coefficients_[i];
+        }
+        Trim();
+        return *this;
     }
-    
+
     template <typename U> requires isNumeric<U>
-    auto operator*(const TPolynomial<U>& p) const -> TPolynomial<std::common_type_t<T, U>> {
+    auto operator*=(const TPolynomial<U>& p) -> TPolynomial<T>& {
         if (this->isZero() || p.isZero()) {
-            return TPolynomial<std::common_type_t<T, U>>::template zero<std::common_type_t<T, U>>();
+            return *this = zero<T>();
         }
 
-        auto resultDegree = this->Degree() + p.Degree();
-        std::vector<std::common_type_t<T, U>> newPolynomial(resultDegree + 1);
-
-        for (std::size_t i {0}; i <= this->Degree(); i++) {
-            for (std::size_t j {0}; j <= p.Degree(); j++) {
-                auto currentCoef = i + j;
-                newPolynomial[resultDegree - currentCoef] += ((*this)[i] * p[j]);
-            }
+        if constexpr (!std::is_same_v<T, U>) {
+            return *this *= p.template Cast<T>();
+        } else {
+            TCoefficients product (Coefficients_.size() + p.Coefficients_.size() - 1, 0);
+            NPrivate::polynomialMul<T>(
+                {Coefficients_.data(), Coefficients_.size()}
+                , {p.Coefficients_.data(), p.Coefficients_.size()}
+                , {product.data(), product.size()}
+            );
+            Coefficients_ = std::move(product);
+            return *this;
         }
-        
-        return TPolynomial<std::common_type_t<T, U>> {newPolynomial};
     }
 
+    // Long division dropping the quotient, every step cancels the leading term
     template <typename U> requires isIntegral<U>
-    auto operator%(const TPolynomial<U>& p) const -> TPolynomial<std::common_type_t<T, U>> {
+    auto operator%=(const TPolynomial<U>& p) -> TPolynomial<T>& {
         if (p.Degree() > this->Degree()) {
             return *this;
         }
-        
-        TPolynomial<std::common_type_t<T, U>> newPolynomial {*this};
 
-        for (std::size_t _d {0}; _d < Degree() + 1 - p.Degree(); _d++) { std::size_t d{Degree() - _d};
-            if (d > newPolynomial.Degree()) {
+        for (std::size_t d {Degree() + 1}; d-- > p.Degree();) {
+            if (d > this->Degree()) {
                 continue;
             }
 
             auto degreeDiff = d - p.Degree();
-            auto coef = newPolynomial[d] / p[p.Degree()];
-
-            auto upPolinomial = TPolynomial<std::common_type_t<T, U>>::template one<std::common_type_t<T, U>>().Pow(degreeDiff);
-            newPolynomial = newPolynomial - (p * upPolinomial * coef);
+            T coef = Coefficients_[d] / p.Coefficients_[p.Degree()];
+            if (coef != 0) {
+                for (std::size_t i {0}; i <= p.Degree(); i++) {
+                    Coefficients_[degreeDiff + i] -= p.Coefficients_[i] * coef;
+                }
+            }
+            Trim();
         }
 
-        return newPolynomial;
+        return *this;
     }
     
     template <typename U> requires isNumeric<U>
@@ -166,7 +238,7 @@ public:
         }
 
         for (std::size_t i {0}; i <= p.Degree(); i++) {
-            if (this->operator[](i) != p[i]) {
+            if (Coefficients_[i] != p.Coefficients_[i]) {
                 return false;
             }
         }
@@ -184,40 +256,68 @@ public:
     }
 
     auto operator*(const T n) const -> TPolynomial<T> {
-        return *this * TPolynomial<T> {n};
+        TPolynomial<T> result {*this};
+        result *= n;
+        return result;
     }
 
     auto operator%(const T n) const -> TPolynomial<T> {
-        std::vector<T> newPolynomial;
-        newPolynomial.reserve(Coefficients_.size());
-        
-        for (std::size_t i {0}; i < Coefficients_.size(); i++) {
-            T currentValue = ((Coefficients_[i] % n) + n) % n;
-            if (currentValue || newPolynomial.size()) {
-                newPolynomial.push_back(currentValue);
-            }
+        TPolynomial<T> result {*this};
+        result %= n;
+        return result;
+    }
+
+    auto operator*=(const T n) -> TPolynomial<T>& {
+        if (this->isZero() || n == 0) {
+            return *this = zero<T>();
         }
+        for (auto& c : Coefficients_) {
+            c *= n;
+        }
+        return *this;
+    }
 
-        if (newPolynomial.size() == 0) return TPolynomial<T>::zero<T>();
-        return TPolynomial<T> {newPolynomial};
+    auto operator%=(const T n) -> TPolynomial<T>& {
+        for (auto& c : Coefficients_) {
+            c = ((c % n) + n) % n;
+        }
+        Trim();
+        return *this;
+    }
+
+    auto Hash() const -> std::size_t {
+        std::size_t result {Coefficients_.size()};
+        for (std::size_t i {Coefficients_.size()}; i > 0; i--) {
+            result = hashCombine(result, std::hash<T> {}(Coefficients_[i - 1]));
+        }
+        return result;
     }
 
     auto isZero() const -> bool {
-        return this->Degree() == 0 && (*this)[0] == 0;
+        return Coefficients_.size() == 1 && Coefficients_[0] == 0;
     }
 
+    // Same text as operator<<, integers skip the stream machinery
     auto ToString() const -> std::string {
-        std::stringstream ss;
-        ss << *this;
-        return ss.str();
+        if constexpr (isIntegral<T>) {
+            std::string out {"("};
+            for (std::size_t i {Degree() + 1}; i > 0; i--) {
+                fmt::format_to(std::back_inserter(out), "{}{}", Coefficients_[i - 1], i != 1 ? ", " : "");
+            }
+            return out += ')';
+        } else {
+            std::stringstream ss;
+            ss << *this;
+            return ss.str();
+        }
     }
 
     friend std::ostream& operator<<(std::ostream& out, const TPolynomial<T>& p) {
         out << '(';
 
-        for (std::size_t i {0}; i <= p.Degree(); i++) {
-            out << p.Coefficients_[i];
-            if (i != p.Degree()) {
+        for (std::size_t i {p.Degree() + 1}; i > 0; i--) {
+            out << p.Coefficients_[i - 1];
+            if (i != 1) {
                 out << ", ";
             }
         }
@@ -237,15 +337,39 @@ public:
     }
 
 private:
-    auto getCoefficientOrZero(const std::size_t degree) const -> const T {
-        if (degree > this->Degree()) {
-            return 0;
+    template <typename U> requires isNumeric<U>
+    friend class TPolynomial;
+
+    // Listed from the lowest degree, so growing and trimming touch the tail only
+    using TCoefficients = utils::TSmallVector<T, InlineDegree + 1>;
+
+    template <typename U>
+    auto Cast() const -> TPolynomial<U> {
+        if constexpr (std::is_same_v<T, U>) {
+            return *this;
+        } else {
+            TPolynomial<U> result = TPolynomial<U>::template zero<U>();
+            result.Coefficients_.assign(Coefficients_.begin(), Coefficients_.end());
+            return result;
+        }
+    }
+
+    // Drops zero leading coefficients, keeping a single one for zero polynomial
+    auto Trim() -> void {
+        while (Coefficients_.size() > 1 && Coefficients_.back() == 0) {
+            Coefficients_.pop_back();
         }
-        return (*this)[degree];
     }
 
 private:
-    std::vector<T> Coefficients_;
+    TCoefficients Coefficients_;
 };
 
 } // namespace kimp::math
+
+template <typename T> requires kimp::math::isNumeric<T>
+struct std::hash<kimp::math::TPolynomial<T>> {
+    auto operator()(const kimp::math::TPolynomial<T>& p) const noexcept -> std::size_t {
+        return p.Hash();
+    }
+};
@@ -1,19 +1,240 @@
 #pragma once
 
+#include <math/gcd.hpp>
+#include <math/modular.hpp>
 #include <math/num.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace kimp::math {
 
+// Primes below 2^16 sieved once, they trial divide any 32-bit number
+inline auto smallPrimes() -> const std::vector<ui32>& {
+    static const std::vector<ui32> primes = [] () {
+        constexpr ui32 limit = 1 << 16;
+        std::vector<bool> composite (limit, false);
+        std::vector<ui32> result;
+        for (ui32 i {2}; i < limit; i++) {
+            if (composite[i]) continue;
+            result.push_back(i);
+            for (ui32 j {i * i}; j < limit; j += i) {
+                composite[j] = true;
+            }
+        }
+        return result;
+    }();
+    return primes;
+}
+
+namespace NPrivate {
+
+inline auto isqrt(ui64 n) -> ui64 {
+    auto root = static_cast<ui64>(std::sqrt(static_cast<double>(n)));
+    while (static_cast<ui128>(root) * root > n) {
+        root--;
+    }
+    while (static_cast<ui128>(root + 1) * (root + 1) <= n) {
+        root++;
+    }
+    return root;
+}
+
+// n - 1 = d 2^s, a is a witness of compositeness unless a^d = 1 or
+// a^(d 2^r) = -1 for some r < s
+inline auto isStrongProbablePrime(ui64 n, ui64 a, const TBarrett& mod) -> bool {
+    a %= n;
+    if (a == 0) {
+        return true;
+    }
+
+    ui64 s = static_cast<ui64>(std::countr_zero(n - 1));
+    ui64 x = mod.Pow(a, (n - 1) >> s);
+    if (x == 1 || x == n - 1) {
+        return true;
+    }
+    for (ui64 r {1}; r < s; r++) {
+        x = mod.Mul(x, x);
+        if (x == n - 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Pollard's rho with Brent's cycle detection, n should be an odd composite.
+// Products of |x - y| are batched so gcd is taken once per 128 steps
+inline auto pollardRho(ui64 n) -> ui64 {
+    TBarrett mod {n};
+    for (ui64 c {1};; c++) {
+        auto f = [&] (ui64 x) { return mod.Add(mod.Mul(x, x), c); };
+        ui64 x {2}, y {2}, ys {2}, q {1}, g {1};
+        constexpr ui64 batch = 128;
+        for (ui64 r {1}; g == 1; r <<= 1) {
+            x = y;
+            for (ui64 i {0}; i < r; i++) {
+                y = f(y);
+            }
+            for (ui64 k {0}; k < r && g == 1; k += batch) {
+                ys = y;
+                for (ui64 i {0}; i < std::min(batch, r - k); i++) {
+                    y = f(y);
+                    q = mod.Mul(q, x > y ? x - y : y - x);
+                }
+                g = binaryGcd(q, n);
+            }
+        }
+        // The batch overshot, replay it step by step
+        if (g == n) {
+            do {
+                ys = f(ys);
+                g = binaryGcd(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n) {
+            return g;
+        }
+    }
+}
+
+} // namespace NPrivate
+
+// Trial division by small primes, then the deterministic Miller-Rabin test
+// with the bases of Jim Sinclair, which has no strong pseudoprimes below 2^64
 template <typename T> requires isUnsignedIntegral<T>
 auto isPrime(T t) -> bool {
-    for (T i {2}; i <= std::sqrt(t); i++) {
-        if (t % i == 0) {
-            return false;
+    ui64 n {t};
+    if (n < 2) {
+        return false;
+    }
+    for (ui32 p : std::span<const ui32> {smallPrimes()}.first(64)) {
+        if (n % p == 0) {
+            return n == p;
         }
     }
-    return true;
+    if (n < 311ull * 311ull) {
+        return true;
+    }
+
+    TBarrett mod {n};
+    constexpr std::array<ui64, 7> bases {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    return std::all_of(bases.begin(), bases.end(), [&] (ui64 a) {
+        return NPrivate::isStrongProbablePrime(n, a, mod);
+    });
+}
+
+// Primes in [from, to) by a segmented sieve of Eratosthenes, memory is
+// bounded by the segment and the primes up to sqrt(to). Ranges shorter
+// than sqrt(to) aren't worth sieving those, Miller-Rabin tests them instead
+inline auto primesInRange(ui64 from, ui64 to) -> std::vector<ui64> {
+    constexpr ui64 segment = 1 << 15;
+    from = std::max<ui64>(from, 2);
+    if (from >= to) {
+        return {};
+    }
+
+    std::vector<ui64> primes;
+    ui64 root = NPrivate::isqrt(to - 1);
+    if (root >= (1 << 16) && to - from < root) {
+        for (ui64 n {from}; n < to; n++) {
+            if (isPrime(n)) {
+                primes.push_back(n);
+            }
+        }
+        return primes;
+    }
+
+    std::vector<ui64> base;
+    if (root < (1 << 16)) {
+        for (ui32 p : smallPrimes()) {
+            if (p > root) break;
+            base.push_back(p);
+        }
+    } else {
+        base = primesInRange(2, root + 1);
+    }
+
+    std::vector<bool> composite (segment);
+    for (ui64 low {from}; low < to; low += std::min(segment, to - low)) {
+        ui64 high = low + std::min(segment, to - low);
+        std::fill(composite.begin(), composite.end(), false);
+        for (ui64 p : base) {
+            if (p > (high - 1) / p) break;
+            // Offsets from low, so nothing overflows near 2^64
+            ui64 first = low < p * p ? p * p - low : (p - low % p) % p;
+            for (ui64 j {first}; j < high - low; j += p) {
+                composite[j] = true;
+            }
+        }
+        for (ui64 i {low}; i < high; i++) {
+            if (!composite[i - low]) {
+                primes.push_back(i);
+            }
+        }
+    }
+    return primes;
+}
+
+// Prime divisors in ascending order with their multiplicities: small primes
+// are divided out, whatever is left splits by Pollard's rho
+template <typename T> requires isUnsignedIntegral<T>
+auto factorize(T t) -> std::vector<std::pair<T, ui64>> {
+    std::vector<std::pair<T, ui64>> factors;
+    ui64 n {t};
+    if (n < 2) {
+        return factors;
+    }
+    for (ui32 p : smallPrimes()) {
+        if (ui64 {p} * p > n) break;
+        if (n % p == 0) {
+            factors.emplace_back(p, 0);
+            while (n % p == 0) {
+                n /= p;
+                factors.back().second++;
+            }
+        }
+    }
+
+    std::vector<ui64> large;
+    for (std::vector<ui64> stack {n}; !stack.empty();) {
+        ui64 m = stack.back();
+        stack.pop_back();
+        if (m == 1) {
+            continue;
+        }
+        if (isPrime(m)) {
+            large.push_back(m);
+            continue;
+        }
+        ui64 d = NPrivate::pollardRho(m);
+        stack.push_back(d);
+        stack.push_back(m / d);
+    }
+
+    std::sort(large.begin(), large.end());
+    for (ui64 p : large) {
+        if (!factors.empty() && factors.back().first == p) {
+            factors.back().second++;
+        } else {
+            factors.emplace_back(static_cast<T>(p), 1);
+        }
+    }
+    return factors;
+}
+
+// Distinct prime divisors in ascending order
+template <typename T> requires isUnsignedIntegral<T>
+auto primeFactors(T t) -> std::vector<T> {
+    std::vector<T> factors;
+    for (auto [r, e] : factorize(t)) {
+        factors.push_back(r);
+    }
+    return factors;
 }
 
 } // namespace kimp::math
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+
+#include <array>
+#include <span>
+
+namespace kimp::math {
+
+template <typename T> requires isIntegral<T>
+auto polynomialToRank(const TPolynomial<T>& p, ui64 base) -> ui64 {
+    ui64 rank {0};
+    for (std::size_t i {0}; i <= p.Degree(); i++) {
+        auto coef = p[p.Degree() - i] % static_cast<T>(base);
+        rank = rank * base + static_cast<ui64>(coef < 0 ? coef + static_cast<T>(base) : coef);
+    }
+    return rank;
+}
+
+template <typename T = i64> requires isIntegral<T>
+auto rankToPolynomial(ui64 rank, ui64 base) -> TPolynomial<T> {
+    if (rank == 0) {
+        return TPolynomial<T>::template zero<T>();
+    }
+
+    // A 64-bit rank has at most 64 digits, they are filled from the lowest one
+    std::array<T, 64> coefficients;
+    std::size_t first {coefficients.size()};
+    while (rank) {
+        coefficients[--first] = static_cast<T>(rank % base);
+        rank /= base;
+    }
+    return TPolynomial<T> {std::span<const T> {coefficients.data() + first, coefficients.size() - first}};
+}
+
+} // namespace kimp::math
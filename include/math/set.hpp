@@ -1,11 +1,13 @@
 #pragma once
 
 #include <math/num.hpp>
+#include <utils/stats.hpp>
 
 #include <iostream>
 #include <initializer_list>
 #include <memory>
 #include <ostream>
+#include <utility>
 #include <vector>
 #include <unordered_set>
 
@@ -33,25 +35,71 @@ private:
     virtual auto PrintTo(std::ostream&) const -> void = 0;
 };
 
+template <typename T>
+class IFiniteSet;
+template <typename T>
+using IFiniteSetPtr = std::shared_ptr<IFiniteSet<T>>;
+
+template <typename T>
+class IFiniteSet : public ISet<T> {
+public:
+    virtual auto Size() const -> std::size_t = 0;
+    virtual auto At(std::size_t) const -> T = 0;
+
+    virtual ~IFiniteSet() {};
+};
+
 template <typename T>
 class TStaticSet;
 template <typename T>
 using TStaticSetPtr = std::shared_ptr<TStaticSet<T>>;
 
+// Elements with std::hash get an open addressing index over their positions,
+// so membership is O(1) and never copies an element
 template <typename T>
-class TStaticSet : public ISet<T> {
+class TStaticSet : public IFiniteSet<T> {
 public:
-    TStaticSet(std::initializer_list<T> elems) : Elements_(elems) {}
+    TStaticSet(std::initializer_list<T> elems) : Elements_(elems) {
+        BuildIndex();
+    }
 
-    TStaticSet(const std::vector<T>& elems) : Elements_(elems) {}
+    TStaticSet(const std::vector<T>& elems) : Elements_(elems) {
+        BuildIndex();
+    }
+
+    TStaticSet(std::vector<T>&& elems) : Elements_(std::move(elems)) {
+        BuildIndex();
+    }
 
     virtual bool contains(const T& e) const override {
-        for (auto el : Elements_) {
-            if (el == e) {
-                return true;
+        KIMP_STATS_COUNT(ContainsProbe);
+        if constexpr (isHashable<T>) {
+            std::size_t hash = std::hash<T> {}(e);
+            for (std::size_t slot = hash & Mask_;; slot = (slot + 1) & Mask_) {
+                const auto& [slotHash, position] = Index_[slot];
+                if (position == 0) {
+                    return false;
+                }
+                if (slotHash == hash && Elements_[position - 1] == e) {
+                    return true;
+                }
             }
+        } else {
+            for (const auto& el : Elements_) {
+                if (el == e) {
+                    return true;
+                }
+            }
+            return false;
         }
-        return false;
+    }
+
+    virtual std::size_t Size() const override {
+        return Elements_.size();
+    }
+
+    virtual T At(std::size_t i) const override {
+        return Elements_.at(i);
     }
 
     auto GetElements() const -> const std::vector<T>& {
@@ -61,6 +109,26 @@ public:
     virtual ~TStaticSet() {}
 
 private:
+    auto BuildIndex() -> void {
+        if constexpr (isHashable<T>) {
+            std::size_t capacity {2};
+            while (capacity < 2 * Elements_.size()) {
+                capacity <<= 1;
+            }
+            Index_.assign(capacity, {0, 0});
+            Mask_ = capacity - 1;
+
+            for (std::size_t i {0}; i < Elements_.size(); i++) {
+                std::size_t hash = std::hash<T> {}(Elements_[i]);
+                std::size_t slot = hash & Mask_;
+                while (Index_[slot].second != 0) {
+                    slot = (slot + 1) & Mask_;
+                }
+                Index_[slot] = {hash, i + 1};
+            }
+        }
+    }
+
     virtual void PrintTo(std::ostream& out) const override {
         out << '{';
 
@@ -76,6 +144,10 @@ private:
 
 private:
     const std::vector<T> Elements_;
+
+    // (hash, position + 1), zero position marks an empty slot
+    std::vector<std::pair<std::size_t, std::size_t>> Index_;
+    std::size_t Mask_ {0};
 };
 
 class TIntegerSet;
@@ -86,6 +158,7 @@ public:
     TIntegerSet() {}
 
     virtual bool contains(const i64& e) const override {
+        KIMP_STATS_COUNT(ContainsProbe);
         return true;
     }
 
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <math/num.hpp>
+#include <math/polynomial.hpp>
+#include <math/rank.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace kimp::math {
+
+class TGaluaStaticTables;
+using TGaluaStaticTablesPtr = std::shared_ptr<TGaluaStaticTables>;
+
+// Runtime view of the Cayley tables of a TStaticGaluaField instantiation,
+// elements are addressed by rank like in TGaluaLogTable. The tables have
+// static storage duration, so the view owns nothing
+class TGaluaStaticTables {
+public:
+    TGaluaStaticTables(ui64 p, ui64 n, std::span<const ui8> sum, std::span<const ui8> mul, std::span<const ui8> inverse)
+        : P_{p}
+        , N_{n}
+        , Q_{inverse.size()}
+        , Sum_{sum}
+        , Mul_{mul}
+        , Inverse_{inverse}
+    {}
+
+    auto GetP() const -> ui64 {
+        return P_;
+    }
+
+    auto GetN() const -> ui64 {
+        return N_;
+    }
+
+    auto Size() const -> ui64 {
+        return Q_;
+    }
+
+    auto Sum(ui64 a, ui64 b) const -> ui64 {
+        return Sum_[a * Q_ + b];
+    }
+
+    auto Mul(ui64 a, ui64 b) const -> ui64 {
+        return Mul_[a * Q_ + b];
+    }
+
+    auto Inverse(ui64 a) const -> ui64 {
+        if (a == 0) {
+            throw std::invalid_argument("Division by zero in Galua field");
+        }
+        return Inverse_[a];
+    }
+
+private:
+    const ui64 P_;
+    const ui64 N_;
+    const ui64 Q_;
+
+    const std::span<const ui8> Sum_;
+    const std::span<const ui8> Mul_;
+    const std::span<const ui8> Inverse_;
+};
+
+// GF(P^N) built modulo the polynomial with coefficients Modulus listed from
+// the highest degree, like TPolynomial ones. Elements are ranks and every
+// operation is a lookup into Cayley tables generated at compile time, so
+// the field costs nothing to set up. A modulus that doesn't produce a field
+// fails to compile
+template <ui64 P, ui64 N, i64... Modulus>
+class TStaticGaluaField {
+public:
+    // Cayley tables take Q^2 bytes each and ranks have to fit into ui8
+    static constexpr ui64 MaxElements = 256;
+
+    static_assert(N >= 1 && sizeof...(Modulus) == N + 1, "Modulus should have degree N");
+
+    static constexpr ui64 Q = [] {
+        ui64 q {1};
+        for (ui64 i {0}; i < N; i++) {
+            q = q > MaxElements ? q : q * P;
+        }
+        return q;
+    }();
+
+    static_assert(P >= 2 && Q <= MaxElements, "Field is too large for compile time tables");
+    static_assert([] {
+        for (ui64 d {2}; d * d <= P; d++) {
+            if (P % d == 0) return false;
+        }
+        return true;
+    }(), "P should be prime");
+
+    class TElement {
+    public:
+        constexpr TElement() = default;
+
+        constexpr explicit TElement(ui64 rank)
+            : Rank_{static_cast<ui8>(rank)}
+        {
+            if (rank >= Q) {
+                throw std::invalid_argument(fmt::format("There is no element with rank {} in F(p = {}, n = {})", rank, P, N));
+            }
+        }
+
+        static auto FromPolynomial(const TPolynomial<i64>& p) -> TElement {
+            if (!p.isZero() && p.Degree() >= N) {
+                throw std::invalid_argument(fmt::format("Polynomial {} doesn't belong to the field", p.ToString()));
+            }
+            return TElement {polynomialToRank(p, P)};
+        }
+
+        constexpr auto Rank() const -> ui64 {
+            return Rank_;
+        }
+
+        auto ToPolynomial() const -> TPolynomial<i64> {
+            return rankToPolynomial(Rank_, P);
+        }
+
+        constexpr auto isZero() const -> bool {
+            return Rank_ == 0;
+        }
+
+        friend constexpr auto operator+(TElement a, TElement b) -> TElement {
+            return FromRank(SumTable[a.Rank_ * Q + b.Rank_]);
+        }
+
+        friend constexpr auto operator-(TElement a) -> TElement {
+            return FromRank(NegTable[a.Rank_]);
+        }
+
+        friend constexpr auto operator-(TElement a, TElement b) -> TElement {
+            return a + -b;
+        }
+
+        friend constexpr auto operator*(TElement a, TElement b) -> TElement {
+            return FromRank(MulTable[a.Rank_ * Q + b.Rank_]);
+        }
+
+        friend constexpr auto operator/(TElement a, TElement b) -> TElement {
+            return a * Inverse(b);
+        }
+
+        friend constexpr auto operator==(TElement a, TElement b) -> bool = default;
+
+        friend auto operator<<(std::ostream& out, TElement a) -> std::ostream& {
+            return out << a.ToPolynomial();
+        }
+
+    private:
+        static constexpr auto FromRank(ui8 rank) -> TElement {
+            TElement e;
+            e.Rank_ = rank;
+            return e;
+        }
+
+    private:
+        ui8 Rank_ {0};
+    };
+
+    static constexpr auto Zero() -> TElement {
+        return TElement {0};
+    }
+
+    static constexpr auto One() -> TElement {
+        return TElement {1};
+    }
+
+    static constexpr auto Inverse(TElement a) -> TElement {
+        if (a.isZero()) {
+            throw std::invalid_argument("Division by zero in Galua field");
+        }
+        return TElement {InverseTable[a.Rank()]};
+    }
+
+    static constexpr auto Pow(TElement a, ui64 e) -> TElement {
+        TElement result = One();
+        for (; e; e >>= 1, a = a * a) {
+            if (e & 1) result = result * a;
+        }
+        return result;
+    }
+
+    // True when base generates the same ideal as Modulus in GF(p)[x]
+    static auto Matches(const TPolynomial<i64>& base, ui64 p, ui64 n) -> bool {
+        if (p != P || n != N || base.Degree() != N) {
+            return false;
+        }
+        std::array<ui64, N + 1> coefficients {};
+        for (ui64 k {0}; k <= N; k++) {
+            coefficients[k] = Reduce(base[k]);
+        }
+        return coefficients[N] != 0 && Monic(coefficients) == MonicModulus;
+    }
+
+    static auto Tables() -> TGaluaStaticTablesPtr {
+        static const auto tables = std::make_shared<TGaluaStaticTables>(P, N, SumTable, MulTable, InverseTable);
+        return tables;
+    }
+
+private:
+    using TDigits = std::array<ui64, N>;
+
+    static constexpr auto Reduce(i64 c) -> ui64 {
+        c %= static_cast<i64>(P);
+        return static_cast<ui64>(c < 0 ? c + static_cast<i64>(P) : c);
+    }
+
+    static constexpr auto PowMod(ui64 b, ui64 e) -> ui64 {
+        ui64 result {1};
+        for (; e; e >>= 1, b = b * b % P) {
+            if (e & 1) result = result * b % P;
+        }
+        return result;
+    }
+
+    // Coefficients from the lowest degree divided by the leading one
+    static constexpr auto Monic(std::array<ui64, N + 1> coefficients) -> std::array<ui64, N + 1> {
+        ui64 leadInverse = PowMod(coefficients[N], P - 2);
+        for (auto& c : coefficients) {
+            c = c * leadInverse % P;
+        }
+        return coefficients;
+    }
+
+    static constexpr std::array<ui64, N + 1> MonicModulus = [] {
+        std::array<i64, N + 1> highestFirst {Modulus...};
+        std::array<ui64, N + 1> coefficients {};
+        for (ui64 k {0}; k <= N; k++) {
+            coefficients[k] = Reduce(highestFirst[N - k]);
+        }
+        if (coefficients[N] == 0) {
+            throw std::invalid_argument("Leading coefficient of the modulus is divisible by p");
+        }
+        return Monic(coefficients);
+    }();
+
+    static constexpr auto ToDigits(ui64 rank) -> TDigits {
+        TDigits digits {};
+        for (ui64 k {0}; k < N; k++, rank /= P) {
+            digits[k] = rank % P;
+        }
+        return digits;
+    }
+
+    static constexpr auto ToRank(const TDigits& digits) -> ui64 {
+        ui64 rank {0};
+        for (ui64 k {N}; k > 0; k--) {
+            rank = rank * P + digits[k - 1];
+        }
+        return rank;
+    }
+
+    static constexpr auto SlowMul(ui64 a, ui64 b) -> ui64 {
+        TDigits da = ToDigits(a), db = ToDigits(b);
+        std::array<ui64, 2 * N - 1> product {};
+        for (ui64 i {0}; i < N; i++) {
+            for (ui64 j {0}; j < N; j++) {
+                product[i + j] = (product[i + j] + da[i] * db[j]) % P;
+            }
+        }
+        for (ui64 k {2 * N - 2}; k >= N; k--) {
+            for (ui64 j {0}; j < N; j++) {
+                product[k - N + j] = (product[k - N + j] + (P - product[k]) * MonicModulus[j]) % P;
+            }
+        }
+
+        TDigits result {};
+        for (ui64 k {0}; k < N; k++) {
+            result[k] = product[k];
+        }
+        return ToRank(result);
+    }
+
+    static constexpr auto SlowPow(ui64 a, ui64 e) -> ui64 {
+        ui64 result {1};
+        for (; e; e >>= 1, a = SlowMul(a, a)) {
+            if (e & 1) result = SlowMul(result, a);
+        }
+        return result;
+    }
+
+    // Discrete logarithms to the first element of order Q - 1, its existence
+    // proves the quotient ring is a field: every non zero element is its power.
+    // Zech logarithms Z(k) = log(1 + g^k) turn the sum table into lookups too
+    struct TLogTables {
+        std::array<ui8, Q> Log;
+        std::array<ui8, Q - 1> Antilog;
+        std::array<ui64, Q - 1> Zech;
+    };
+
+    static constexpr ui64 ZechInfinity = Q;
+
+    static constexpr TLogTables LogTables = [] {
+        ui64 order = Q - 1;
+        std::array<ui64, 8> divisors {};
+        ui64 divisorsCount {0};
+        for (ui64 rest {order}, d {2}; rest > 1; d++) {
+            if (rest % d == 0) {
+                divisors[divisorsCount++] = d;
+                while (rest % d == 0) rest /= d;
+            }
+        }
+
+        ui64 generator {0};
+        for (ui64 g {1}; g < Q && generator == 0; g++) {
+            bool primitive = SlowPow(g, order) == 1;
+            for (ui64 i {0}; i < divisorsCount && primitive; i++) {
+                primitive = SlowPow(g, order / divisors[i]) != 1;
+            }
+            generator = primitive ? g : 0;
+        }
+        if (generator == 0) {
+            throw std::invalid_argument("Modulus doesn't produce a field");
+        }
+
+        TLogTables tables {};
+        for (ui64 k {0}, current {1}; k < order; k++, current = SlowMul(current, generator)) {
+            tables.Antilog[k] = static_cast<ui8>(current);
+            tables.Log[current] = static_cast<ui8>(k);
+        }
+        for (ui64 k {0}; k < order; k++) {
+            ui64 a = tables.Antilog[k];
+            ui64 onePlusA = a - a % P + (a % P + 1) % P;
+            tables.Zech[k] = onePlusA == 0 ? ZechInfinity : tables.Log[onePlusA];
+        }
+        return tables;
+    }();
+
+    static constexpr std::array<ui8, Q * Q> SumTable = [] {
+        std::array<ui8, Q * Q> table {};
+        for (ui64 i {0}; i < Q * Q; i++) {
+            ui64 a = i / Q, b = i % Q;
+            if (a == 0 || b == 0) {
+                table[i] = static_cast<ui8>(a + b);
+                continue;
+            }
+            // g^la + g^lb = g^la * (1 + g^(lb - la))
+            ui64 la = LogTables.Log[a], lb = LogTables.Log[b];
+            ui64 zech = LogTables.Zech[(lb + Q - 1 - la) % (Q - 1)];
+            table[i] = zech == ZechInfinity ? 0 : LogTables.Antilog[(la + zech) % (Q - 1)];
+        }
+        return table;
+    }();
+
+    static constexpr std::array<ui8, Q * Q> MulTable = [] {
+        std::array<ui8, Q * Q> table {};
+        for (ui64 i {0}; i < Q * Q; i++) {
+            if (ui64 a = i / Q, b = i % Q; a && b) {
+                table[i] = LogTables.Antilog[(LogTables.Log[a] + LogTables.Log[b]) % (Q - 1)];
+            }
+        }
+        return table;
+    }();
+
+    static constexpr std::array<ui8, Q> NegTable = [] {
+        std::array<ui8, Q> table {};
+        for (ui64 a {0}; a < Q; a++) {
+            TDigits digits = ToDigits(a);
+            for (auto& d : digits) {
+                d = (P - d) % P;
+            }
+            table[a] = static_cast<ui8>(ToRank(digits));
+        }
+        return table;
+    }();
+
+    static constexpr std::array<ui8, Q> InverseTable = [] {
+        std::array<ui8, Q> table {};
+        for (ui64 a {1}; a < Q; a++) {
+            table[a] = LogTables.Antilog[(Q - 1 - LogTables.Log[a]) % (Q - 1)];
+        }
+        return table;
+    }();
+};
+
+template <ui64 P, ui64 N, i64... Modulus>
+using GF = TStaticGaluaField<P, N, Modulus...>;
+
+template <typename... TFields>
+auto findGaluaStaticTablesAmong(const TPolynomial<i64>& base, ui64 p, ui64 n) -> TGaluaStaticTablesPtr {
+    TGaluaStaticTablesPtr tables;
+    ((tables = !tables && TFields::Matches(base, p, n) ? TFields::Tables() : tables), ...);
+    return tables;
+}
+
+// Moduli TGaluaField dispatches to compile time tables for. Every header user
+// pays for generating them, so GF(2^8) and other fields with 64K entry tables
+// are left to TGaluaBinaryArithmetic and TGaluaLogTable
+inline auto findGaluaStaticTables(const TPolynomial<i64>& base, ui64 p, ui64 n) -> TGaluaStaticTablesPtr {
+    return findGaluaStaticTablesAmong<
+        GF<2, 2, 1, 1, 1>
+        , GF<2, 3, 1, 0, 1, 1>
+        , GF<2, 4, 1, 0, 0, 1, 1>
+        , GF<3, 2, 1, 2, 2>
+        , GF<3, 3, 1, 0, 2, 1>
+        , GF<5, 2, 1, 1, 2>
+    >(base, p, n);
+}
+
+} // namespace kimp::math
@@ -19,7 +19,7 @@ using TAlgebraicStructurePtr = std::shared_ptr<TAlgebraicStructure<T>>;
 template <typename T>
 class TAlgebraicStructure {
 public:
-    TAlgebraicStructure(const ISetPtr<T> set, const IMathOperationPtr<T> operation, T zero = 0, T one = 1)
+    TAlgebraicStructure(const ISetPtr<T> set, const IMathOperationPtr<T> operation, T zero = 0, T one = 1, EClosureCheck closureCheck = EClosureCheck::Full)
         : Set_{set}
         , Operation_{operation}
         , Zero_{zero}
@@ -31,7 +31,7 @@ public:
         if (!Operation_->IsUnambiguousFor(Set_)) {
             throw std::invalid_argument("Operation for algebraic structure should be unambiguous for given set");
         }
-        if (!Operation_->IsClosedFor(Set_)) {
+        if (!Operation_->IsClosedFor(Set_, closureCheck)) {
             throw std::invalid_argument("Operation for algebraic structure should be closed for given set");
         }
     }
@@ -73,7 +73,7 @@ public:
             throw std::invalid_argument("Behaviour is undefined for used operation type");
         }
 
-        if (TStaticSetPtr<T> sSet = std::dynamic_pointer_cast<TStaticSet<T>>(Set_); sSet) {
+        if (IFiniteSetPtr<T> fSet = std::dynamic_pointer_cast<IFiniteSet<T>>(Set_); fSet) {
             /*if (IsAdditive()) {
                 for (auto e : sSet->GetElements()) {
                     if (!sSet->contains(-e)) {
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kimp::utils {
+
+constexpr std::size_t DefaultChunkSize = 1 << 20;
+
+class IChunkReader;
+using IChunkReaderPtr = std::unique_ptr<IChunkReader>;
+
+class IChunkReader {
+public:
+    // Returns an empty span at the end of input, the span stays valid until the next call
+    virtual auto Next() -> std::span<const std::byte> = 0;
+
+    // True if returned spans stay valid as long as the reader itself
+    virtual auto IsStable() const -> bool {
+        return false;
+    }
+
+    virtual ~IChunkReader() {}
+};
+
+class TMappedFileReader : public IChunkReader {
+public:
+    TMappedFileReader(int fd, std::size_t size, std::size_t chunkSize);
+
+    virtual auto Next() -> std::span<const std::byte> override;
+
+    virtual auto IsStable() const -> bool override {
+        return true;
+    }
+
+    virtual ~TMappedFileReader();
+
+private:
+    const std::byte* Data_;
+    const std::size_t Size_;
+    const std::size_t ChunkSize_;
+
+    std::size_t Offset_;
+};
+
+// Reads from pipes and terminals into two buffers by turns: the background
+// thread fills one of them while the caller works with the other
+class TDoubleBufferedReader : public IChunkReader {
+public:
+    TDoubleBufferedReader(int fd, std::size_t chunkSize);
+
+    virtual auto Next() -> std::span<const std::byte> override;
+
+    virtual ~TDoubleBufferedReader();
+
+private:
+    auto ReadLoop() -> void;
+
+private:
+    struct TBuffer {
+        std::vector<std::byte> Data;
+        std::size_t Size {0};
+        bool Ready {false};
+    };
+
+    const int Fd_;
+
+    std::array<TBuffer, 2> Buffers_;
+    std::size_t Current_;
+    bool Started_;
+
+    bool Finished_;
+    bool Stopped_;
+    std::string Error_;
+
+    std::mutex Mutex_;
+    std::condition_variable Cv_;
+    std::thread Thread_;
+};
+
+class TChunkWriter;
+using TChunkWriterPtr = std::unique_ptr<TChunkWriter>;
+
+class TChunkWriter {
+public:
+    TChunkWriter(int fd, bool owned);
+
+    auto Write(std::span<const std::byte> data) -> void;
+
+    // Reports write errors deferred until close (full disk, NFS), the
+    // destructor closes silently when this wasn't called
+    auto Close() -> void;
+
+    ~TChunkWriter();
+
+private:
+    const int Fd_;
+    const bool Owned_;
+
+    bool Closed_;
+};
+
+// "-" stands for stdin, regular files are memory mapped
+auto openChunkReader(const std::string& path, std::size_t chunkSize = DefaultChunkSize) -> IChunkReaderPtr;
+
+// "-" stands for stdout
+auto openChunkWriter(const std::string& path) -> TChunkWriterPtr;
+
+} // namespace kimp::utils
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <utils/io.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace kimp::utils {
+
+// Must be safe to call from several threads at once
+using TChunkTransform = std::function<void(std::span<const std::byte>, std::span<std::byte>)>;
+
+class TChunkPipeline;
+using TChunkPipelinePtr = std::shared_ptr<TChunkPipeline>;
+
+// Reader stage, a pool of workers transforming whole chunks and a writer stage
+// putting results back in input order, connected by bounded lock-free queues.
+// With one thread chunks are transformed in place of the caller
+class TChunkPipeline {
+public:
+    TChunkPipeline(TChunkTransform transform, std::size_t threads = 1);
+
+    // Returns the number of processed bytes
+    auto Run(IChunkReader& reader, TChunkWriter& writer) const -> std::size_t;
+
+    auto GetThreads() const -> std::size_t {
+        return Threads_;
+    }
+
+private:
+    auto RunSerial(IChunkReader& reader, TChunkWriter& writer) const -> std::size_t;
+    auto RunParallel(IChunkReader& reader, TChunkWriter& writer) const -> std::size_t;
+
+private:
+    const TChunkTransform Transform_;
+    const std::size_t Threads_;
+};
+
+} // namespace kimp::utils
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace kimp::utils {
+
+// Bounded multi-producer multi-consumer queue over a ring of cells, each cell
+// carries a sequence number telling whose turn it is (D. Vyukov's scheme).
+// Push/Pop never take a lock, blocking variants back off until the cell is
+// free or the cancel flag is raised
+template <typename T>
+class TBoundedQueue {
+public:
+    explicit TBoundedQueue(std::size_t capacity)
+        : Capacity_{roundUpToPowerOfTwo(capacity)}
+        , Mask_{Capacity_ - 1}
+        , Cells_{std::make_unique<TCell[]>(Capacity_)}
+        , Head_{0}
+        , Tail_{0}
+    {
+        for (std::size_t i {0}; i < Capacity_; i++) {
+            Cells_[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    TBoundedQueue(const TBoundedQueue&) = delete;
+    auto operator=(const TBoundedQueue&) -> TBoundedQueue& = delete;
+
+    auto Capacity() const -> std::size_t {
+        return Capacity_;
+    }
+
+    auto TryPush(const T& value) -> bool {
+        std::size_t position = Tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            TCell& cell = Cells_[position & Mask_];
+            std::size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (diff == 0) {
+                if (Tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.Value = value;
+                    cell.Sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = Tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto TryPop(T& value) -> bool {
+        std::size_t position = Head_.load(std::memory_order_relaxed);
+        for (;;) {
+            TCell& cell = Cells_[position & Mask_];
+            std::size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (diff == 0) {
+                if (Head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.Value;
+                    cell.Sequence.store(position + Capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = Head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false if cancelled before the value got into the queue
+    auto Push(const T& value, const std::atomic<bool>& cancel) -> bool {
+        for (std::size_t attempt {0}; !TryPush(value); attempt++) {
+            if (cancel.load(std::memory_order_relaxed)) return false;
+            backoff(attempt);
+        }
+        return true;
+    }
+
+    // Returns false if cancelled before a value was taken
+    auto Pop(T& value, const std::atomic<bool>& cancel) -> bool {
+        for (std::size_t attempt {0}; !TryPop(value); attempt++) {
+            if (cancel.load(std::memory_order_relaxed)) return false;
+            backoff(attempt);
+        }
+        return true;
+    }
+
+private:
+    static auto roundUpToPowerOfTwo(std::size_t n) -> std::size_t {
+        if (n < 2) {
+            throw std::invalid_argument("Bounded queue capacity should be at least 2");
+        }
+        std::size_t result {1};
+        while (result < n) result <<= 1;
+        return result;
+    }
+
+    static auto backoff(std::size_t attempt) -> void {
+        if (attempt < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+private:
+    struct TCell {
+        std::atomic<std::size_t> Sequence;
+        T Value;
+    };
+
+    const std::size_t Capacity_;
+    const std::size_t Mask_;
+    std::unique_ptr<TCell[]> Cells_;
+
+    alignas(64) std::atomic<std::size_t> Head_;
+    alignas(64) std::atomic<std::size_t> Tail_;
+};
+
+} // namespace kimp::utils
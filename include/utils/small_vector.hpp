@@ -0,0 +1,142 @@
+#pragma once
+
+#include <utils/stats.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace kimp::utils {
+
+// Contiguous storage keeping up to InlineCapacity values inside the object,
+// the heap is touched only when it grows past that. Values are trivially
+// copyable, so growing and copying are plain memory moves
+template <typename T, std::size_t InlineCapacity>
+class TSmallVector {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    TSmallVector() = default;
+
+    TSmallVector(std::size_t size, const T& value) {
+        resize(size, value);
+    }
+
+    TSmallVector(const TSmallVector& other) {
+        assign(other.begin(), other.end());
+    }
+
+    TSmallVector(TSmallVector&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    auto operator=(const TSmallVector& other) -> TSmallVector& {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    auto operator=(TSmallVector&& other) noexcept -> TSmallVector& {
+        if (this == &other) {
+            return *this;
+        }
+        if (other.Heap_) {
+            Heap_ = std::move(other.Heap_);
+            Capacity_ = other.Capacity_;
+        } else {
+            std::copy(other.Inline_, other.Inline_ + other.Size_, data());
+        }
+        Size_ = other.Size_;
+        other.Size_ = 0;
+        other.Capacity_ = InlineCapacity;
+        return *this;
+    }
+
+    template <typename TIterator>
+    auto assign(TIterator first, TIterator last) -> void {
+        Size_ = 0;
+        reserve(static_cast<std::size_t>(std::distance(first, last)));
+        Size_ = static_cast<std::size_t>(std::copy(first, last, data()) - data());
+    }
+
+    auto size() const -> std::size_t {
+        return Size_;
+    }
+
+    auto empty() const -> bool {
+        return Size_ == 0;
+    }
+
+    auto capacity() const -> std::size_t {
+        return Capacity_;
+    }
+
+    auto data() -> T* {
+        return Heap_ ? Heap_.get() : Inline_;
+    }
+
+    auto data() const -> const T* {
+        return Heap_ ? Heap_.get() : Inline_;
+    }
+
+    auto begin() -> T* { return data(); }
+    auto end() -> T* { return data() + Size_; }
+    auto begin() const -> const T* { return data(); }
+    auto end() const -> const T* { return data() + Size_; }
+
+    auto operator[](std::size_t i) -> T& {
+        return data()[i];
+    }
+
+    auto operator[](std::size_t i) const -> const T& {
+        return data()[i];
+    }
+
+    auto back() -> T& {
+        return data()[Size_ - 1];
+    }
+
+    auto back() const -> const T& {
+        return data()[Size_ - 1];
+    }
+
+    auto reserve(std::size_t capacity) -> void {
+        if (capacity <= Capacity_) {
+            return;
+        }
+        capacity = std::max(capacity, 2 * Capacity_);
+        KIMP_STATS_COUNT(PolynomialAllocation);
+        auto heap = std::make_unique_for_overwrite<T[]>(capacity);
+        std::copy(begin(), end(), heap.get());
+        Heap_ = std::move(heap);
+        Capacity_ = capacity;
+    }
+
+    auto resize(std::size_t size, T value = T {}) -> void {
+        reserve(size);
+        if (size > Size_) {
+            std::fill(data() + Size_, data() + size, value);
+        }
+        Size_ = size;
+    }
+
+    auto push_back(T value) -> void {
+        reserve(Size_ + 1);
+        data()[Size_++] = value;
+    }
+
+    auto pop_back() -> void {
+        Size_--;
+    }
+
+private:
+    T Inline_[InlineCapacity];
+    std::unique_ptr<T[]> Heap_;
+    std::size_t Size_ {0};
+    std::size_t Capacity_ {InlineCapacity};
+};
+
+} // namespace kimp::utils
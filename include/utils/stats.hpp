@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kimp::utils {
+
+enum class EStatsCounter : std::size_t {
+    OperationApply
+    , PolynomialAllocation
+    , ContainsProbe
+    , ClosureCheck
+    , Count
+};
+
+auto statsCounterName(EStatsCounter counter) -> std::string_view;
+
+// Call counters and wall clock phases of the hot paths. Nothing is recorded
+// until Enable, then every thread bumps counters of its own block, so workers
+// never share a cache line. Building with KIMP_DISABLE_STATS drops the
+// KIMP_STATS_* probes from the code altogether
+class TStats {
+public:
+    // Times are microseconds since the statistics were created
+    struct TPhase {
+        std::string Name;
+        std::uint64_t Start;
+        std::uint64_t Duration;
+        std::uint64_t Thread;
+    };
+
+    static auto Get() -> TStats& {
+        static TStats stats;
+        return stats;
+    }
+
+    auto Enable() -> void {
+        Enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    auto IsEnabled() const -> bool {
+        return Enabled_.load(std::memory_order_relaxed);
+    }
+
+    auto Count(EStatsCounter counter) -> void {
+        if (!IsEnabled()) {
+            return;
+        }
+        // Only the owner thread writes its block, a plain increment is enough
+        auto& value = LocalBlock().Counters[static_cast<std::size_t>(counter)];
+        value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    auto Now() const -> std::uint64_t {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - Origin_
+        ).count());
+    }
+
+    auto AddPhase(std::string name, std::uint64_t start, std::uint64_t duration) -> void {
+        std::uint64_t thread = LocalBlock().Thread;
+        std::lock_guard lock {Mutex_};
+        Phases_.push_back({std::move(name), start, duration, thread});
+    }
+
+    // Sum over all threads
+    auto GetCounter(EStatsCounter counter) const -> std::uint64_t;
+
+    auto GetPhases() const -> std::vector<TPhase>;
+
+    auto Reset() -> void;
+
+    // Counters and phases aggregated by name, as a text table or a JSON object
+    auto FormatTable() const -> std::string;
+    auto FormatJson() const -> std::string;
+
+    // Phases as complete events of the Chrome trace event format, counters go
+    // as one counter event at the end
+    auto WriteChromeTrace(const std::string& path) const -> void;
+
+private:
+    struct alignas(64) TBlock {
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(EStatsCounter::Count)> Counters {};
+        std::uint64_t Thread {0};
+    };
+
+    TStats()
+        : Origin_{std::chrono::steady_clock::now()}
+    {}
+
+    auto LocalBlock() -> TBlock& {
+        thread_local TBlock* block = RegisterBlock();
+        return *block;
+    }
+
+    // Blocks outlive their threads, counters of finished workers still count
+    auto RegisterBlock() -> TBlock* {
+        std::lock_guard lock {Mutex_};
+        Blocks_.push_back(std::make_unique<TBlock>());
+        Blocks_.back()->Thread = Blocks_.size();
+        return Blocks_.back().get();
+    }
+
+private:
+    std::atomic<bool> Enabled_ {false};
+    const std::chrono::steady_clock::time_point Origin_;
+
+    mutable std::mutex Mutex_;
+    std::vector<std::unique_ptr<TBlock>> Blocks_;
+    std::vector<TPhase> Phases_;
+};
+
+// Records the wall clock time of its scope as a phase
+class TScopedTimer {
+public:
+    explicit TScopedTimer(std::string name)
+        : Enabled_{TStats::Get().IsEnabled()}
+        , Start_{Enabled_ ? TStats::Get().Now() : 0}
+        , Name_{Enabled_ ? std::move(name) : std::string {}}
+    {}
+
+    TScopedTimer(const TScopedTimer&) = delete;
+    auto operator=(const TScopedTimer&) -> TScopedTimer& = delete;
+
+    ~TScopedTimer() {
+        if (Enabled_) {
+            TStats::Get().AddPhase(std::move(Name_), Start_, TStats::Get().Now() - Start_);
+        }
+    }
+
+private:
+    const bool Enabled_;
+    const std::uint64_t Start_;
+    std::string Name_;
+};
+
+} // namespace kimp::utils
+
+#define KIMP_STATS_CONCAT_IMPL(a, b) a##b
+#define KIMP_STATS_CONCAT(a, b) KIMP_STATS_CONCAT_IMPL(a, b)
+
+#ifndef KIMP_DISABLE_STATS
+#define KIMP_STATS_COUNT(counter) ::kimp::utils::TStats::Get().Count(::kimp::utils::EStatsCounter::counter)
+#define KIMP_STATS_SCOPE(name) const ::kimp::utils::TScopedTimer KIMP_STATS_CONCAT(kimpStatsScope, __LINE__) {name}
+#else
+#define KIMP_STATS_COUNT(counter) static_cast<void>(0)
+#define KIMP_STATS_SCOPE(name) static_cast<void>(0)
+#endif
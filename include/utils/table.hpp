@@ -0,0 +1,153 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kimp::utils {
+
+// Square table of labels framed as
+//  ----------
+//  |  |a |b |
+//  ----------
+//  |a |a |b |
+//  ----------
+// Every label is padded once, rows are put together in a reused buffer that
+// goes to the stream by large writes
+class TTableRenderer {
+public:
+    static constexpr std::size_t FlushSize = 1 << 20;
+
+    explicit TTableRenderer(const std::vector<std::string>& labels) {
+        std::size_t width {0};
+        for (const auto& label : labels) {
+            width = std::max(width, label.size());
+        }
+
+        Cells_.reserve(labels.size());
+        for (const auto& label : labels) {
+            fmt::format_to(std::back_inserter(Cells_.emplace_back()), "|{:<{}}", label, width);
+        }
+        Corner_ = fmt::format("|{:<{}}", "", width);
+        HLine_ = fmt::format("{:->{}}\n", "", (width + 1) * (labels.size() + 1) + 1);
+    }
+
+    // cell(row, column) is the index of the label at their crossing
+    template <typename TCell>
+    auto Render(std::ostream& out, const TCell& cell) const -> void {
+        std::string buffer;
+        buffer.reserve(std::min(FlushSize, HLine_.size() * (2 * Cells_.size() + 3)) + 2 * HLine_.size());
+        auto flush = [&] () {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        };
+
+        buffer += HLine_;
+        buffer += Corner_;
+        for (const auto& c : Cells_) {
+            buffer += c;
+        }
+        buffer += "|\n";
+        buffer += HLine_;
+
+        for (std::size_t row {0}; row < Cells_.size(); row++) {
+            buffer += Cells_[row];
+            for (std::size_t column {0}; column < Cells_.size(); column++) {
+                buffer += Cells_[cell(row, column)];
+            }
+            buffer += "|\n";
+            buffer += HLine_;
+            if (buffer.size() >= FlushSize) {
+                flush();
+            }
+        }
+        flush();
+    }
+
+private:
+    std::vector<std::string> Cells_;
+    std::string Corner_;
+    std::string HLine_;
+};
+
+namespace NPrivate {
+
+// RFC 4180 quoting, only fields with separators, quotes or line breaks need it
+inline auto csvField(std::string_view s) -> std::string {
+    if (s.find_first_of(",\"\r\n") == std::string_view::npos) {
+        return std::string {s};
+    }
+    std::string result {"\""};
+    for (char ch : s) {
+        if (ch == '"') {
+            result += '"';
+        }
+        result += ch;
+    }
+    return result += '"';
+}
+
+} // namespace NPrivate
+
+// The same table as CSV: the header row and the first column hold the labels
+template <typename TCell>
+auto writeCsvTable(std::ostream& out, const std::vector<std::string>& labels, const TCell& cell) -> void {
+    std::vector<std::string> fields;
+    fields.reserve(labels.size());
+    for (const auto& label : labels) {
+        fields.push_back(NPrivate::csvField(label));
+    }
+
+    std::string buffer;
+    auto line = [&] (std::string_view head, auto&& field) {
+        buffer += head;
+        for (std::size_t column {0}; column < fields.size(); column++) {
+            buffer += ',';
+            buffer += field(column);
+        }
+        buffer += "\r\n";
+        if (buffer.size() >= TTableRenderer::FlushSize) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    };
+
+    line("", [&] (std::size_t column) -> const std::string& { return fields[column]; });
+    for (std::size_t row {0}; row < fields.size(); row++) {
+        line(fields[row], [&] (std::size_t column) -> const std::string& { return fields[cell(row, column)]; });
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+// The size followed by size^2 label indices row by row, all of them little
+// endian 64-bit integers whatever the host is
+template <typename TCell>
+auto writeBinaryTable(std::ostream& out, std::size_t size, const TCell& cell) -> void {
+    std::vector<char> buffer;
+    auto put = [&] (std::uint64_t v) {
+        for (std::size_t i {0}; i < 8; i++, v >>= 8) {
+            buffer.push_back(static_cast<char>(v & 0xFF));
+        }
+    };
+
+    put(size);
+    for (std::size_t row {0}; row < size; row++) {
+        for (std::size_t column {0}; column < size; column++) {
+            put(cell(row, column));
+        }
+        if (buffer.size() >= TTableRenderer::FlushSize) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+} // namespace kimp::utils
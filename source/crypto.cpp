@@ -3,32 +3,58 @@
 
 #include "math/deduction.hpp"
 #include "math/field.hpp"
+#include "math/irreducible.hpp"
 #include "math/set.hpp"
 #include <math/polynomial.hpp>
-
+#include <cipher/affine.hpp>
+#include <utils/io.hpp>
+#include <utils/pipeline.hpp>
+#include <utils/stats.hpp>
+#include <utils/table.hpp>
+
+#include <algorithm>
+#include <array>
 #include <exception>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 
 #include <argparse/argparse.hpp>
 #include <fmt/format.h>
 #include <memory>
 #include <stdexcept>
-#include <unordered_map>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace kimp {
 
-TCryptoApp::TCryptoApp() {}
+TCryptoApp::TCryptoApp()
+    : CipherAlphabet_{" abcdefghijklmnopqrstuvwxyz"}
+    , Stats_{false}
+{}
 
 auto TCryptoApp::run(int argc, char ** argv) -> int {
-    switch (ParseCommandLineArguments(argc, argv)) {
+    auto mode = ParseCommandLineArguments(argc, argv);
+    if (Stats_ || !TracePath_.empty()) {
+        utils::TStats::Get().Enable();
+    }
+
+    int code {-1};
+    switch (mode) {
         case EAppMode::GaluaAppMode:
-            return RunGaluaMode();
+            code = RunGaluaMode();
+            break;
         case EAppMode::CipherAppMode:
-            return RunCipherMode();
+            code = RunCipherMode();
+            break;
         default:
             return -1;
     }
+
+    ReportStats();
+    return code;
 }
 
 auto TCryptoApp::RunGaluaMode() const -> int {
@@ -66,6 +92,7 @@ auto TCryptoApp::RunGaluaMode() const -> int {
 
     std::cout << "[Step 3] Building Galua field..." << std::endl;
     TGaluaFieldPtr galuaField = BuildGaluaField(polynomial);
+    if (!galuaField) return -1;
 
     std::cout << "[Step 4] Exploring of multiplicative group of the galua field" << std::endl;
     ExploreMultiplicativeGroup(galuaField);
@@ -76,6 +103,7 @@ auto TCryptoApp::RunGaluaMode() const -> int {
 }
 
 auto TCryptoApp::BuildSimpleEndlessField() const -> TFieldPtr<TDeductionClass<ui64>> {
+    KIMP_STATS_SCOPE("step 1: simple field");
     try {
         return std::make_shared<TField<TDeductionClass<ui64>>>(GaluaP_);
     } catch (const std::exception& e) {
@@ -88,24 +116,58 @@ auto TCryptoApp::BuildSimpleEndlessField() const -> TFieldPtr<TDeductionClass<ui
 auto TCryptoApp::GeneratePolynomialForGaluaField(
     const TFieldPtr<TDeductionClass<ui64>>& simpleEndlessFied
 ) const -> TPolynomialPtr<i64> {
+    KIMP_STATS_SCOPE("step 2: polynomial search");
     if (GaluaP_ == 3 && GaluaN_ == 2) {
         return std::make_shared<TPolynomial<i64>>(std::vector<i64> {2, 1, 1});
     }
-    for (int d1 {1}; d1 < GaluaN_; d1++) {
-        for (int k1 {1}; k1 < GaluaP_; k1++) {
-            for (int k0 {1}; k0 < GaluaP_; k0++) {
-                TPolynomial<i64> temp = TPolynomial<i64>::one<i64>().Pow(GaluaN_);
-                temp = temp + (TPolynomial<i64>::one<i64>().Pow(d1) * k1);
-                temp = temp + TPolynomial<i64> {k0};
 
-                auto tempPtr = std::make_shared<TPolynomial<i64>>(temp);
-                if (IsPolynomialSuitableForGaluaFieldBuilding(simpleEndlessFied, tempPtr)) {
-                    return tempPtr;
+    // Trinomials x^n + k1 * x^d1 + k0 go first, primitive ones are preferred
+    // since x then generates F*, an irreducible one is enough otherwise
+    TPolynomialPtr<i64> irreducible;
+    auto consider = [&] (const TPolynomial<i64>& candidate) {
+        if (!isIrreducible(candidate, GaluaP_)) {
+            return false;
+        }
+        if (!irreducible) {
+            irreducible = std::make_shared<TPolynomial<i64>>(candidate);
+        }
+        return isPrimitive(candidate, GaluaP_);
+    };
+
+    for (ui64 d1 {1}; d1 < GaluaN_; d1++) {
+        for (ui64 k1 {1}; k1 < GaluaP_; k1++) {
+            for (ui64 k0 {1}; k0 < GaluaP_; k0++) {
+                std::vector<i64> coefficients (GaluaN_ + 1, 0);
+                coefficients[0] = 1;
+                coefficients[GaluaN_ - d1] = static_cast<i64>(k1);
+                coefficients[GaluaN_] = static_cast<i64>(k0);
+
+                if (TPolynomial<i64> candidate {coefficients}; consider(candidate)) {
+                    return std::make_shared<TPolynomial<i64>>(candidate);
                 }
             }
         }
     }
-    return nullptr;
+    if (irreducible) {
+        return irreducible;
+    }
+
+    // Some degrees have no irreducible trinomials, walk all monic polynomials then
+    ui64 tail {1};
+    for (ui64 i {0}; i < GaluaN_ && tail <= std::numeric_limits<ui64>::max() / GaluaP_; i++) {
+        tail *= GaluaP_;
+    }
+    for (ui64 rank {1}; rank < tail; rank++) {
+        std::vector<i64> coefficients (GaluaN_ + 1, 0);
+        coefficients[0] = 1;
+        for (ui64 k {GaluaN_}, r {rank}; r; k--, r /= GaluaP_) {
+            coefficients[k] = static_cast<i64>(r % GaluaP_);
+        }
+        if (TPolynomial<i64> candidate {coefficients}; consider(candidate)) {
+            return std::make_shared<TPolynomial<i64>>(candidate);
+        }
+    }
+    return irreducible;
 }
 
 auto TCryptoApp::EnterPolynomialForGaluaField() const -> TPolynomialPtr<i64> {
@@ -123,197 +185,157 @@ auto TCryptoApp::IsPolynomialSuitableForGaluaFieldBuilding(
     const TFieldPtr<TDeductionClass<ui64>>& simpleEndlessFied
     , const TPolynomialPtr<i64>& p
 ) const -> bool {
-    for (const auto& dc : std::dynamic_pointer_cast<TStaticSet<TDeductionClass<ui64>>>(simpleEndlessFied->GetElements())->GetElements()) {
-        if (p->Calc(dc.GetA()) % GaluaP_ == 0) return false;
-    }
-    return true;
+    KIMP_STATS_SCOPE("step 2: irreducibility check");
+    return p->Degree() == GaluaN_ && isIrreducible(*p, GaluaP_);
 }
 
 auto TCryptoApp::BuildGaluaField(const TPolynomialPtr<i64>& p) const -> TGaluaFieldPtr {
-    auto f = std::make_shared<TGaluaField>(p, GaluaP_, GaluaN_);
+    TGaluaFieldPtr f;
+    {
+        KIMP_STATS_SCOPE("step 3: field construction");
+        f = std::make_shared<TGaluaField>(p, GaluaP_, GaluaN_);
+    }
 
-    std::size_t maxPolynomialDisplaySize = 0;
+    KIMP_STATS_SCOPE("step 3: tables output");
 
-    std::cout << "[Step 3] Built Galua field with " << f->GetElements().size() << " elements, display them: ";
+    // Elements and their strings are made once, table cells look them up by rank
+    std::vector<TPolynomial<i64>> elements;
+    std::vector<std::string> labels;
+    std::string line;
     for (const auto& e : f->GetElements()) {
-        maxPolynomialDisplaySize = std::max({maxPolynomialDisplaySize, e.ToString().size()});
-        std::cout << e << " ";
-    } std::cout << std::endl << std::endl;
+        elements.push_back(e);
+        labels.push_back(e.ToString());
+        line += labels.back();
+        line += ' ';
+    }
+    std::cout << "[Step 3] Built Galua field with " << elements.size() << " elements, display them: " << line << std::endl << std::endl;
 
-    auto printHLine = [&] () {
-        for (std::size_t i{0}; i < (maxPolynomialDisplaySize + 1) * (f->GetElements().size() + 1) + 1; i++) {
-            std::cout << '-';
-        }
-        std::cout << std::endl;
-    };
-    auto printCell = [maxPolynomialDisplaySize] (const std::string& content = "") {
-        std::cout << '|' << content;
-        for (std::size_t i {content.size()}; i < maxPolynomialDisplaySize; i++) {
-            std::cout << ' ';
+    if (GaluaTablesFormat_ == "none") {
+        std::cout << "[Step 3] Operation tables are skipped" << std::endl;
+        return f;
+    }
+
+    const std::array<std::tuple<std::string, std::string, IMathOperationPtr<TPolynomial<i64>>>, 2> tables {{
+        {"additive", "sum", f->GetSumOperation()}
+        , {"multiplicative", "mul", f->GetMulOperation()}
+    }};
+    for (std::size_t i {0}; i < tables.size(); i++) {
+        const auto& [name, suffix, op] = tables[i];
+        auto cell = [&] (std::size_t row, std::size_t column) {
+            return f->IndexOf(op->Apply(elements[row], elements[column]));
+        };
+
+        if (GaluaTablesFormat_ == "text") {
+            std::cout << fmt::format("[Step 3] [SubStep {}] Gonna display the {} table", i + 1, name) << std::endl;
+            utils::TTableRenderer {labels}.Render(std::cout, cell);
+            std::cout << std::endl;
+            continue;
         }
-    };
-    auto printHeader = [&] () {
-        printHLine(); printCell();
-        for (const auto& e : f->GetElements()) {
-            printCell(e.ToString());
+
+        auto path = fmt::format("{}_{}.{}", GaluaExportPrefix_, suffix, GaluaTablesFormat_ == "csv" ? "csv" : "bin");
+        std::cout << fmt::format("[Step 3] [SubStep {}] Gonna write the {} table to {}", i + 1, name, path) << std::endl;
+        std::ofstream file {path, std::ios::binary};
+        if (GaluaTablesFormat_ == "csv") {
+            utils::writeCsvTable(file, labels, cell);
+        } else {
+            utils::writeBinaryTable(file, labels.size(), cell);
         }
-        std::cout << '|' << std::endl;
-        printHLine();
-    };
-    auto printOperationRow = [&] (const TPolynomial<i64>& p, const IMathOperationPtr<TPolynomial<i64>>& op) {
-        printCell(p.ToString());
-        for (const auto& e : f->GetElements()) {
-            printCell(op->Apply(p, e).ToString());
+        if (!file.flush()) {
+            std::cerr << fmt::format("Unable to write the {} table to '{}'", name, path) << std::endl;
+            return nullptr;
         }
-        std::cout << '|' << std::endl;
-        printHLine();
-    };
-
-    std::cout << "[Step 3] [SubStep 1] Gonna display the additive table" << std::endl;
-    printHeader(); 
-    for (const auto& e : f->GetElements()) {
-        printOperationRow(e, f->GetSumOperation());
-    } std::cout << std::endl;
-    
-    std::cout << "[Step 3] [SubStep 2] Gonna display the multiplicative table" << std::endl;
-    printHeader(); 
-    for (const auto& e : f->GetElements()) {
-        printOperationRow(e, f->GetMulOperation());
-    } std::cout << std::endl;
+    }
 
     return f;
 }
 
 auto TCryptoApp::ExploreMultiplicativeGroup(const TGaluaFieldPtr& gf) const -> void {
+    KIMP_STATS_SCOPE("step 4: multiplicative group");
     std::cout << "[Step 4] F*(n) is like {1";
     for (std::size_t i {1}; i < gf->GetElements().size(); i++) {
         std::cout << ", a^" << i; 
     } std::cout << "}" << std::endl;
 
-    std::unordered_map<i64, std::vector<TPolynomial<i64>>> orderToElements;
-    for (const auto& e : gf->GetElements()) {
-        auto isOne = [] (const TPolynomial<i64>& p) {
-            return !p.isZero() && p.Degree() == 0 && p[0] == 1;
-        };
-        
-        if (e.isZero() || isOne(e)) {
-            continue;
+    auto printGenerators = [&] (const TGaluaSubgroup& subgroup) {
+        std::vector<ui64> ranks;
+        for (const auto& e : subgroup.GetGenerators()) {
+            ranks.push_back(gf->IndexOf(e));
         }
+        std::sort(ranks.begin(), ranks.end());
+        for (ui64 rank : ranks) {
+            std::cout << " = <" << gf->At(rank) << ">";
+        } std::cout << std::endl;
+    };
 
-        TPolynomial<i64> temp {e};
-        i64 order = 1;
-        
-        while (!isOne(temp)) {
-            temp = gf->GetMulOperation()->Apply(temp, e);
-            order++;
-        }
-
-        if (!orderToElements.contains(order)) {
-            orderToElements[order] = std::vector<TPolynomial<i64>> ();
-        }
-        orderToElements[order].push_back(e);
-    }
-
-    i64 baseOrder = gf->GetElements().size() - 1;
-    if (!orderToElements.contains(baseOrder)) {
-        std::cout << "Something got wrong... Abort" << std::endl;
-        return;
-    }
-
+    // Proper subgroups from the largest, the trivial one isn't listed
+    auto subgroups = gf->Subgroups();
     std::cout << "[Step 4] F*(n)";
-    for (const auto& e : orderToElements[baseOrder]) {
-        std::cout << " = <" << e << ">";
-    } std::cout << std::endl;
-
-    std::vector<i64> subOrders;
-    subOrders.reserve(orderToElements.size() - 1);
-
-    for (const auto& it : orderToElements) {
-        if (it.first != baseOrder) {
-            subOrders.push_back(it.first);
-        }
-    }
-    std::sort(subOrders.begin(), subOrders.end());
-
-    for (std::size_t i {1}; i <= subOrders.size(); i++) {
+    printGenerators(subgroups.back());
+    for (std::size_t i {1}; i + 1 < subgroups.size(); i++) {
         std::cout << "[Step 4] H" << i;
-        for (const auto& e : orderToElements[subOrders[subOrders.size() - i]]) {
-            std::cout << " = <" << e << ">";
-        } std::cout << std::endl;
+        printGenerators(subgroups[subgroups.size() - 1 - i]);
     }
 }
 
 auto TCryptoApp::RunCipherMode() const -> int {
-    std::string alphabet = " abcdefghijklmnopqrstuvwxyz";
+    if (!CipherInput_.empty()) {
+        return RunCipherStreamMode();
+    }
+    if (CipherValue_.empty()) {
+        std::cerr << "Nothing to process, pass a value or use --in" << std::endl;
+        return -1;
+    }
+    if (CipherBytes_ || CipherThreads_ != 1) {
+        std::cerr << "Byte cipher and threads work only with --in/--out streams" << std::endl;
+        return -1;
+    }
+
+    const std::string& alphabet = CipherAlphabet_;
     std::cout << "Gonna use alphabet of " << alphabet.length() << " symbols '" << alphabet << "'" << std::endl;
 
-    auto basePolynomial = std::make_shared<TPolynomial<i64>> (std::vector<i64> {1, 0, 2, 1});
-    std::cout << "Gonna use F(n = 3, p = 3) with " << *basePolynomial << " base" << std::endl;
+    std::cout << "Gonna use F(n = 3, p = 3) with " << *CipherBasePolynomial() << " base" << std::endl;
 
-    auto galuaField = std::make_shared<TGaluaField> (basePolynomial, 3, 3);
+    auto [aKey, bKey] = ReadCipherKey(std::cout);
 
-    char aKey, bKey;
-    std::cout << "Enter A part of key: ";
-    std::cin >> aKey;
-    
-    std::cout << "Enter B part of key: ";
-    std::cin >> bKey;
+    auto symbolIndex = BuildCipherSymbolIndex();
 
     auto charToPol = [&] (char ch) {
-        return galuaField->GetElements().at(alphabet.find(ch));
+        return TCipherField::TElement {symbolIndex[static_cast<ui8>(ch)]};
     };
 
-    auto polToChar = [&] (const TPolynomial<i64>& p) {
-        for (std::size_t i {0}; i < galuaField->GetElements().size(); i++) {
-            if (galuaField->GetElements().at(i) == p) {
-                return alphabet[i];
-            }
-        }
-        return ' ';
+    auto polToChar = [&] (TCipherField::TElement p) {
+        return alphabet[p.Rank()];
     };
 
-    TPolynomial<i64> a = charToPol(aKey), b = charToPol(bKey);
+    auto a = charToPol(aKey), b = charToPol(bKey);
 
     std::cout << "Key is (" << a << " x " << b << ")" << std::endl;
 
+    KIMP_STATS_SCOPE(CipherIsEncoding_ ? "cipher: encode" : "cipher: decode");
     if (CipherIsEncoding_) {
         std::cout << "Going to hide the text: " << CipherValue_ << std::endl;
         std::string result = "";
         for (char from : CipherValue_) {
-            auto resultPolynomial = galuaField->GetSumOperation()->Apply(
-                galuaField->GetMulOperation()->Apply(
-                    a,
-                    charToPol(from)
-                ),
-                b
-            );
+            auto resultPolynomial = a * charToPol(from) + b;
             char to = polToChar(resultPolynomial);
-            std::cout << from << " -> " << charToPol(from) << " * " << a << " + " << b << " = " << resultPolynomial << " -> " << to << std::endl;
+            if (!CipherQuiet_) {
+                std::cout << from << " -> " << charToPol(from) << " * " << a << " + " << b << " = " << resultPolynomial << " -> " << to << '\n';
+            }
             result += to;
         }
         std::cout << "Encoding done, your cipher text is '" << result << "'" << std::endl;
     } else {
-        auto getReversed = [&] (const TPolynomial<i64>& p) {
-            for (const auto& e : galuaField->GetElements()) {
-                auto mulOp = galuaField->GetMulOperation()->Apply(e, p);
-                if (!mulOp.isZero() && mulOp.Degree() == 0 && mulOp[0] == 1) {
-                    return e;
-                }
-            }
-            throw std::invalid_argument("Unable to find reversed value for " + p.ToString());
-        };
+        auto reversed = TCipherField::Inverse(a);
 
         std::cout << "Going to extract text from '" << CipherValue_ << "'" << std::endl;
         std::string result = "";
         for (char from : CipherValue_) {
-            auto reversed = getReversed(a);
-            auto resultPolynomial = galuaField->GetMulOperation()->Apply(
-                (charToPol(from) - b) % 3,
-                reversed
-            );
+            auto resultPolynomial = (charToPol(from) - b) * reversed;
             char to = polToChar(resultPolynomial);
             result += to;
-            std::cout << from << " -> (" << charToPol(from) << " - " << b << ") * " << reversed << " = " << resultPolynomial << " -> " << to << "(" << reversed << " is " << a << "^-1)" << std::endl;
+            if (!CipherQuiet_) {
+                std::cout << from << " -> (" << charToPol(from) << " - " << b << ") * " << reversed << " = " << resultPolynomial << " -> " << to << "(" << reversed << " is " << a << "^-1)" << '\n';
+            }
         }
         std::cout << "Your open text is '" << result << "'" << std::endl;
     }
@@ -321,9 +343,145 @@ auto TCryptoApp::RunCipherMode() const -> int {
     return 0;
 }
 
+auto TCryptoApp::RunCipherStreamMode() const -> int {
+    try {
+        if (CipherInput_ == "-" && CipherKey_.empty()) {
+            throw std::invalid_argument("Key can't be entered interactively while reading stdin, use --key");
+        }
+        auto [aKey, bKey] = ReadCipherKey(std::cerr);
+
+        utils::TChunkTransform transform;
+        if (CipherBytes_) {
+            auto byteCipher = std::make_shared<cipher::TAffineByteCipher>(static_cast<std::byte>(aKey), static_cast<std::byte>(bKey));
+            transform = [byteCipher, encoding = CipherIsEncoding_] (std::span<const std::byte> in, std::span<std::byte> out) {
+                KIMP_STATS_SCOPE("cipher: chunk");
+                encoding ? byteCipher->Encode(in, out) : byteCipher->Decode(in, out);
+            };
+        } else {
+            transform = [table = BuildAlphabetCipherTable(aKey, bKey)] (std::span<const std::byte> in, std::span<std::byte> out) {
+                KIMP_STATS_SCOPE("cipher: chunk");
+                for (std::size_t i {0}; i < in.size(); i++) {
+                    out[i] = table[static_cast<ui8>(in[i])];
+                }
+            };
+        }
+
+        auto reader = utils::openChunkReader(CipherInput_);
+        auto writer = utils::openChunkWriter(CipherOutput_.empty() ? "-" : CipherOutput_);
+
+        utils::TChunkPipeline pipeline {transform, CipherThreads_};
+        std::size_t total {0};
+        {
+            KIMP_STATS_SCOPE("cipher: stream");
+            total = pipeline.Run(*reader, *writer);
+        }
+        writer->Close();
+
+        if (!CipherQuiet_) {
+            std::cerr << fmt::format("{} done, processed {} bytes", CipherIsEncoding_ ? "Encoding" : "Decoding", total) << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format("Something got wrong: {}", e.what()) << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+auto TCryptoApp::CipherBasePolynomial() const -> TPolynomialPtr<i64> {
+    return std::make_shared<TPolynomial<i64>> (std::vector<i64> {1, 0, 2, 1});
+}
+
+auto TCryptoApp::ReadCipherKey(std::ostream& prompt) const -> std::pair<char, char> {
+    if (!CipherKey_.empty()) {
+        if (CipherKey_.size() != 2) {
+            throw std::invalid_argument(fmt::format("Key should consist of two symbols, got '{}'", CipherKey_));
+        }
+        return {CipherKey_[0], CipherKey_[1]};
+    }
+
+    char aKey, bKey;
+    prompt << "Enter A part of key: " << std::flush;
+    std::cin >> aKey;
+
+    prompt << "Enter B part of key: " << std::flush;
+    std::cin >> bKey;
+
+    return {aKey, bKey};
+}
+
+auto TCryptoApp::BuildCipherSymbolIndex() const -> std::array<ui64, 256> {
+    std::array<ui64, 256> index;
+    index.fill(std::numeric_limits<ui64>::max());
+    for (std::size_t i {0}; i < CipherAlphabet_.size(); i++) {
+        index[static_cast<ui8>(CipherAlphabet_[i])] = i;
+    }
+    return index;
+}
+
+auto TCryptoApp::BuildAlphabetCipherTable(char aKey, char bKey) const -> std::array<std::byte, 256> {
+    auto symbolIndex = BuildCipherSymbolIndex();
+
+    auto keyPart = [&] (char ch) {
+        if (symbolIndex[static_cast<ui8>(ch)] >= TCipherField::Q) {
+            throw std::invalid_argument(fmt::format("Symbol '{}' is not in the alphabet", ch));
+        }
+        return TCipherField::TElement {symbolIndex[static_cast<ui8>(ch)]};
+    };
+
+    auto a = keyPart(aKey), b = keyPart(bKey);
+    auto reversed = TCipherField::Inverse(a);
+
+    std::array<std::byte, 256> table;
+    for (std::size_t i {0}; i < table.size(); i++) {
+        table[i] = static_cast<std::byte>(i);
+    }
+
+    for (ui64 i {0}; i < TCipherField::Q; i++) {
+        auto x = TCipherField::TElement {i};
+        auto to = CipherIsEncoding_ ? a * x + b : (x - b) * reversed;
+        table[static_cast<ui8>(CipherAlphabet_[i])] = static_cast<std::byte>(CipherAlphabet_[to.Rank()]);
+    }
+    return table;
+}
+
+auto TCryptoApp::ReportStats() const -> void {
+    if (!Stats_ && TracePath_.empty()) {
+        return;
+    }
+#ifdef KIMP_DISABLE_STATS
+    std::cerr << "Statistics are compiled out of this build, nothing to report" << std::endl;
+#else
+    const auto& stats = utils::TStats::Get();
+    if (Stats_) {
+        std::cerr << (StatsFormat_ == "json" ? stats.FormatJson() : stats.FormatTable()) << std::flush;
+    }
+    if (!TracePath_.empty()) {
+        try {
+            stats.WriteChromeTrace(TracePath_);
+        } catch (const std::exception& e) {
+            std::cerr << fmt::format("Something got wrong: {}", e.what()) << std::endl;
+        }
+    }
+#endif
+}
+
 auto TCryptoApp::ParseCommandLineArguments(int argc, char ** argv) -> EAppMode {
     argparse::ArgumentParser crypto {"crypto"};
 
+    auto addStatsArguments = [] (argparse::ArgumentParser& mode) {
+        mode.add_argument("--stats")
+            .help("Print operation counters and phase timings to stderr when done")
+            .flag();
+
+        mode.add_argument("--stats-format")
+            .help("Format of --stats, 'table' or 'json'")
+            .default_value(std::string {"table"});
+
+        mode.add_argument("--trace")
+            .help("Write phases as a Chrome trace event file, see chrome://tracing")
+            .default_value(std::string {});
+    };
+
     // -------------------- Configure galua cli args --------------------
     argparse::ArgumentParser galuaMode {"galua"};
 
@@ -339,11 +497,50 @@ auto TCryptoApp::ParseCommandLineArguments(int argc, char ** argv) -> EAppMode {
         .help("Automatically generate polynomial for Galua field")
         .flag();
 
+    galuaMode.add_argument("--format")
+        .help("How to output operation tables: 'text', 'csv', 'binary' or 'none'")
+        .default_value(std::string {"text"});
+
+    galuaMode.add_argument("--export")
+        .help("Path prefix of csv and binary tables, _sum and _mul are appended to it")
+        .default_value(std::string {"cayley"});
+
+    addStatsArguments(galuaMode);
+
     // -------------------- Configure cipher cli args --------------------
     argparse::ArgumentParser cipherMode {"cipher"};
 
     cipherMode.add_argument("value")
-        .help("String for athenian coding process");
+        .help("String for athenian coding process")
+        .default_value(std::string {})
+        .nargs(argparse::nargs_pattern::optional);
+
+    cipherMode.add_argument("--in")
+        .help("File to process chunk by chunk instead of value, '-' stands for stdin")
+        .default_value(std::string {});
+
+    cipherMode.add_argument("--out")
+        .help("File for the result of --in processing, '-' stands for stdout")
+        .default_value(std::string {"-"});
+
+    cipherMode.add_argument("--key")
+        .help("Two symbols of the key, asked interactively if omitted")
+        .default_value(std::string {});
+
+    cipherMode.add_argument("--quiet")
+        .help("Don't print per symbol trace and statistics")
+        .flag();
+
+    cipherMode.add_argument("--threads")
+        .help("Number of worker threads encoding --in chunks in parallel")
+        .default_value(ui64 {1})
+        .scan<'i', ui64>();
+
+    cipherMode.add_argument("--bytes")
+        .help("Treat --in as raw bytes and use affine cipher over GF(2^8)")
+        .flag();
+
+    addStatsArguments(cipherMode);
 
     auto& decodeEncodeGroup = cipherMode.add_mutually_exclusive_group(true);
 
@@ -366,17 +563,47 @@ auto TCryptoApp::ParseCommandLineArguments(int argc, char ** argv) -> EAppMode {
         return EAppMode::NoAppMode;
     }
 
+    auto readStatsArguments = [&] (const argparse::ArgumentParser& mode) {
+        Stats_ = mode.get<bool>("--stats");
+        StatsFormat_ = mode.get("--stats-format");
+        TracePath_ = mode.get("--trace");
+        if (StatsFormat_ != "table" && StatsFormat_ != "json") {
+            std::cerr << fmt::format("Unknown statistics format '{}', use 'table' or 'json'", StatsFormat_) << std::endl;
+            return false;
+        }
+        return true;
+    };
+
     if (crypto.is_subcommand_used(galuaMode)) {
+        if (!readStatsArguments(galuaMode)) {
+            return EAppMode::NoAppMode;
+        }
         GaluaN_ = galuaMode.get<ui64>("n");
         GaluaP_ = galuaMode.get<ui64>("p");
         GaluaAutogen_ = galuaMode.get<bool>("--autogen");
+        GaluaTablesFormat_ = galuaMode.get("--format");
+        GaluaExportPrefix_ = galuaMode.get("--export");
+
+        if (GaluaTablesFormat_ != "text" && GaluaTablesFormat_ != "csv" && GaluaTablesFormat_ != "binary" && GaluaTablesFormat_ != "none") {
+            std::cerr << fmt::format("Unknown tables format '{}', use 'text', 'csv', 'binary' or 'none'", GaluaTablesFormat_) << std::endl;
+            return EAppMode::NoAppMode;
+        }
 
         return EAppMode::GaluaAppMode;
     }
 
     if (crypto.is_subcommand_used(cipherMode)) {
+        if (!readStatsArguments(cipherMode)) {
+            return EAppMode::NoAppMode;
+        }
         CipherValue_ = cipherMode.get("value");
         CipherIsEncoding_ = cipherMode.is_used("--encode");
+        CipherInput_ = cipherMode.get("--in");
+        CipherOutput_ = cipherMode.get("--out");
+        CipherKey_ = cipherMode.get("--key");
+        CipherQuiet_ = cipherMode.get<bool>("--quiet");
+        CipherBytes_ = cipherMode.get<bool>("--bytes");
+        CipherThreads_ = cipherMode.get<ui64>("--threads");
 
         return EAppMode::CipherAppMode;
     }
@@ -0,0 +1,195 @@
+#include <utils/io.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace kimp::utils {
+
+namespace {
+
+auto systemError(const std::string& what, int error = errno) -> std::runtime_error {
+    return std::runtime_error(fmt::format("{}: {}", what, std::strerror(error)));
+}
+
+} // namespace
+
+TMappedFileReader::TMappedFileReader(int fd, std::size_t size, std::size_t chunkSize)
+    : Data_{nullptr}
+    , Size_{size}
+    , ChunkSize_{chunkSize}
+    , Offset_{0}
+{
+    void* data = Size_ ? ::mmap(nullptr, Size_, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    int error = errno;
+
+    if (fd != STDIN_FILENO) {
+        ::close(fd);
+    }
+    if (data == MAP_FAILED) {
+        throw systemError("Unable to map input file", error);
+    }
+    if (data) {
+        ::madvise(data, Size_, MADV_SEQUENTIAL);
+        Data_ = static_cast<const std::byte*>(data);
+    }
+}
+
+auto TMappedFileReader::Next() -> std::span<const std::byte> {
+    std::size_t size = std::min(ChunkSize_, Size_ - Offset_);
+    std::span<const std::byte> chunk {Data_ + Offset_, size};
+    Offset_ += size;
+    return chunk;
+}
+
+TMappedFileReader::~TMappedFileReader() {
+    if (Data_) {
+        ::munmap(const_cast<std::byte*>(Data_), Size_);
+    }
+}
+
+TDoubleBufferedReader::TDoubleBufferedReader(int fd, std::size_t chunkSize)
+    : Fd_{fd}
+    , Current_{0}
+    , Started_{false}
+    , Finished_{false}
+    , Stopped_{false}
+{
+    for (auto& buffer : Buffers_) {
+        buffer.Data.resize(chunkSize);
+    }
+    Thread_ = std::thread([this] () { ReadLoop(); });
+}
+
+auto TDoubleBufferedReader::ReadLoop() -> void {
+    for (std::size_t i {0};; i ^= 1) {
+        auto& buffer = Buffers_[i];
+        {
+            std::unique_lock lock {Mutex_};
+            Cv_.wait(lock, [&] () { return !buffer.Ready || Stopped_; });
+            if (Stopped_) return;
+        }
+
+        std::size_t size {0};
+        while (size < buffer.Data.size()) {
+            ssize_t got = ::read(Fd_, buffer.Data.data() + size, buffer.Data.size() - size);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0) {
+                std::lock_guard lock {Mutex_};
+                Error_ = std::strerror(errno);
+                Finished_ = true;
+                Cv_.notify_all();
+                return;
+            }
+            if (got == 0) break;
+            size += static_cast<std::size_t>(got);
+        }
+
+        std::lock_guard lock {Mutex_};
+        buffer.Size = size;
+        buffer.Ready = true;
+        Finished_ = size < buffer.Data.size();
+        Cv_.notify_all();
+        if (Finished_) return;
+    }
+}
+
+auto TDoubleBufferedReader::Next() -> std::span<const std::byte> {
+    std::unique_lock lock {Mutex_};
+    if (Started_) {
+        Buffers_[Current_].Ready = false;
+        Current_ ^= 1;
+        Cv_.notify_all();
+    }
+    Started_ = true;
+
+    auto& buffer = Buffers_[Current_];
+    Cv_.wait(lock, [&] () { return buffer.Ready || Finished_; });
+    if (!buffer.Ready) {
+        if (!Error_.empty()) {
+            throw std::runtime_error(fmt::format("Unable to read input: {}", Error_));
+        }
+        return {};
+    }
+    return {buffer.Data.data(), buffer.Size};
+}
+
+TDoubleBufferedReader::~TDoubleBufferedReader() {
+    {
+        std::lock_guard lock {Mutex_};
+        Stopped_ = true;
+        Cv_.notify_all();
+    }
+    Thread_.join();
+    if (Fd_ != STDIN_FILENO) {
+        ::close(Fd_);
+    }
+}
+
+TChunkWriter::TChunkWriter(int fd, bool owned)
+    : Fd_{fd}
+    , Owned_{owned}
+    , Closed_{false}
+{}
+
+auto TChunkWriter::Write(std::span<const std::byte> data) -> void {
+    while (!data.empty()) {
+        ssize_t written = ::write(Fd_, data.data(), data.size());
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0) {
+            throw systemError("Unable to write output");
+        }
+        data = data.subspan(static_cast<std::size_t>(written));
+    }
+}
+
+auto TChunkWriter::Close() -> void {
+    if (!Owned_ || Closed_) {
+        return;
+    }
+    Closed_ = true;
+    if (::close(Fd_) != 0) {
+        throw systemError("Unable to write output");
+    }
+}
+
+TChunkWriter::~TChunkWriter() {
+    if (Owned_ && !Closed_) {
+        ::close(Fd_);
+    }
+}
+
+auto openChunkReader(const std::string& path, std::size_t chunkSize) -> IChunkReaderPtr {
+    int fd = path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw systemError(fmt::format("Unable to open '{}'", path));
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        return std::make_unique<TMappedFileReader>(fd, static_cast<std::size_t>(info.st_size), chunkSize);
+    }
+    return std::make_unique<TDoubleBufferedReader>(fd, chunkSize);
+}
+
+auto openChunkWriter(const std::string& path) -> TChunkWriterPtr {
+    if (path == "-") {
+        return std::make_unique<TChunkWriter>(STDOUT_FILENO, false);
+    }
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw systemError(fmt::format("Unable to open '{}'", path));
+    }
+    return std::make_unique<TChunkWriter>(fd, true);
+}
+
+} // namespace kimp::utils
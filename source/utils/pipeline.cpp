@@ -0,0 +1,160 @@
+#include <utils/pipeline.hpp>
+#include <utils/queue.hpp>
+
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace kimp::utils {
+
+namespace {
+
+// Chunks in flight per worker, bounds both memory and reordering distance
+constexpr std::size_t SlotsPerThread = 4;
+
+constexpr std::size_t StopSlot = std::numeric_limits<std::size_t>::max();
+
+struct TSlot {
+    std::size_t Sequence {0};
+    std::span<const std::byte> Source;
+    std::vector<std::byte> Input;
+    std::vector<std::byte> Output;
+};
+
+} // namespace
+
+TChunkPipeline::TChunkPipeline(TChunkTransform transform, std::size_t threads)
+    : Transform_{std::move(transform)}
+    , Threads_{threads}
+{
+    if (Threads_ == 0) {
+        throw std::invalid_argument("Pipeline needs at least one worker thread");
+    }
+}
+
+auto TChunkPipeline::Run(IChunkReader& reader, TChunkWriter& writer) const -> std::size_t {
+    return Threads_ == 1 ? RunSerial(reader, writer) : RunParallel(reader, writer);
+}
+
+auto TChunkPipeline::RunSerial(IChunkReader& reader, TChunkWriter& writer) const -> std::size_t {
+    std::vector<std::byte> buffer;
+    std::size_t total {0};
+    for (auto chunk = reader.Next(); !chunk.empty(); chunk = reader.Next()) {
+        buffer.resize(chunk.size());
+        Transform_(chunk, buffer);
+        writer.Write(buffer);
+        total += chunk.size();
+    }
+    return total;
+}
+
+auto TChunkPipeline::RunParallel(IChunkReader& reader, TChunkWriter& writer) const -> std::size_t {
+    const std::size_t window = Threads_ * SlotsPerThread;
+
+    std::vector<TSlot> slots (window);
+    TBoundedQueue<std::size_t> freeSlots {window};
+    TBoundedQueue<std::size_t> work {window + Threads_};
+    TBoundedQueue<std::size_t> done {window + Threads_};
+    for (std::size_t i {0}; i < window; i++) {
+        freeSlots.TryPush(i);
+    }
+
+    std::atomic<bool> cancel {false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto fail = [&] () {
+        std::lock_guard lock {errorMutex};
+        if (!error) {
+            error = std::current_exception();
+        }
+        cancel.store(true);
+    };
+
+    std::thread readerThread ([&] () {
+        try {
+            std::size_t sequence {0};
+            for (auto chunk = reader.Next(); !chunk.empty(); chunk = reader.Next()) {
+                std::size_t s;
+                if (!freeSlots.Pop(s, cancel)) return;
+
+                auto& slot = slots[s];
+                slot.Sequence = sequence++;
+                if (reader.IsStable()) {
+                    slot.Source = chunk;
+                } else {
+                    slot.Input.assign(chunk.begin(), chunk.end());
+                    slot.Source = slot.Input;
+                }
+                if (!work.Push(s, cancel)) return;
+            }
+            for (std::size_t i {0}; i < Threads_; i++) {
+                work.Push(StopSlot, cancel);
+            }
+        } catch (...) {
+            fail();
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (std::size_t t {0}; t < Threads_; t++) {
+        workers.emplace_back([&] () {
+            try {
+                std::size_t s;
+                while (work.Pop(s, cancel)) {
+                    if (s == StopSlot) {
+                        done.Push(StopSlot, cancel);
+                        return;
+                    }
+                    auto& slot = slots[s];
+                    slot.Output.resize(slot.Source.size());
+                    Transform_(slot.Source, slot.Output);
+                    if (!done.Push(s, cancel)) return;
+                }
+            } catch (...) {
+                fail();
+            }
+        });
+    }
+
+    // Results come in any order, a chunk is written once all the previous ones are
+    std::size_t total {0};
+    try {
+        std::vector<std::size_t> pending (window, StopSlot);
+        std::size_t next {0}, stopped {0}, s;
+        while (stopped < Threads_ && done.Pop(s, cancel)) {
+            if (s == StopSlot) {
+                stopped++;
+                continue;
+            }
+            pending[slots[s].Sequence % window] = s;
+
+            while (pending[next % window] != StopSlot) {
+                std::size_t ready = std::exchange(pending[next % window], StopSlot);
+                auto& slot = slots[ready];
+                writer.Write(std::span<const std::byte> {slot.Output}.first(slot.Source.size()));
+                total += slot.Source.size();
+
+                freeSlots.Push(ready, cancel);
+                next++;
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+
+    readerThread.join();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return total;
+}
+
+} // namespace kimp::utils
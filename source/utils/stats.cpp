@@ -0,0 +1,166 @@
+#include <utils/stats.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace kimp::utils {
+
+namespace {
+
+struct TPhaseSummary {
+    std::uint64_t Calls {0};
+    std::uint64_t Total {0};
+    std::uint64_t Max {0};
+};
+
+auto summarizePhases(const std::vector<TStats::TPhase>& phases) -> std::map<std::string, TPhaseSummary> {
+    std::map<std::string, TPhaseSummary> summary;
+    for (const auto& phase : phases) {
+        auto& s = summary[phase.Name];
+        s.Calls++;
+        s.Total += phase.Duration;
+        s.Max = std::max(s.Max, phase.Duration);
+    }
+    return summary;
+}
+
+// Names are ours, only quotes and backslashes need escaping
+auto jsonString(std::string_view s) -> std::string {
+    std::string result {"\""};
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            result += '\\';
+        }
+        result += ch;
+    }
+    return result += '"';
+}
+
+constexpr auto counters() -> std::array<EStatsCounter, static_cast<std::size_t>(EStatsCounter::Count)> {
+    return {
+        EStatsCounter::OperationApply
+        , EStatsCounter::PolynomialAllocation
+        , EStatsCounter::ContainsProbe
+        , EStatsCounter::ClosureCheck
+    };
+}
+
+} // namespace
+
+auto statsCounterName(EStatsCounter counter) -> std::string_view {
+    switch (counter) {
+        case EStatsCounter::OperationApply:
+            return "operation_apply";
+        case EStatsCounter::PolynomialAllocation:
+            return "polynomial_allocation";
+        case EStatsCounter::ContainsProbe:
+            return "contains_probe";
+        case EStatsCounter::ClosureCheck:
+            return "closure_check";
+        default:
+            throw std::invalid_argument("Unknown statistics counter");
+    }
+}
+
+auto TStats::GetCounter(EStatsCounter counter) const -> std::uint64_t {
+    std::lock_guard lock {Mutex_};
+    std::uint64_t sum {0};
+    for (const auto& block : Blocks_) {
+        sum += block->Counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+auto TStats::GetPhases() const -> std::vector<TPhase> {
+    std::lock_guard lock {Mutex_};
+    return Phases_;
+}
+
+auto TStats::Reset() -> void {
+    std::lock_guard lock {Mutex_};
+    for (const auto& block : Blocks_) {
+        for (auto& value : block->Counters) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+    Phases_.clear();
+}
+
+auto TStats::FormatTable() const -> std::string {
+    std::string out;
+    auto it = std::back_inserter(out);
+
+    fmt::format_to(it, "{:<24} {:>16}\n", "counter", "calls");
+    for (auto counter : counters()) {
+        fmt::format_to(it, "{:<24} {:>16}\n", statsCounterName(counter), GetCounter(counter));
+    }
+
+    auto phases = summarizePhases(GetPhases());
+    if (!phases.empty()) {
+        fmt::format_to(it, "\n{:<32} {:>10} {:>14} {:>14}\n", "phase", "calls", "total ms", "max ms");
+        for (const auto& [name, s] : phases) {
+            fmt::format_to(it, "{:<32} {:>10} {:>14.3f} {:>14.3f}\n", name, s.Calls, s.Total / 1e3, s.Max / 1e3);
+        }
+    }
+    return out;
+}
+
+auto TStats::FormatJson() const -> std::string {
+    std::string out;
+    auto it = std::back_inserter(out);
+
+    fmt::format_to(it, "{{\"counters\": {{");
+    for (auto counter : counters()) {
+        fmt::format_to(it, "{}{}: {}", counter == counters().front() ? "" : ", ", jsonString(statsCounterName(counter)), GetCounter(counter));
+    }
+
+    fmt::format_to(it, "}}, \"phases\": {{");
+    bool first {true};
+    for (const auto& [name, s] : summarizePhases(GetPhases())) {
+        fmt::format_to(
+            it, "{}{}: {{\"calls\": {}, \"total_us\": {}, \"max_us\": {}}}"
+            , std::exchange(first, false) ? "" : ", ", jsonString(name), s.Calls, s.Total, s.Max
+        );
+    }
+    fmt::format_to(it, "}}}}\n");
+    return out;
+}
+
+auto TStats::WriteChromeTrace(const std::string& path) const -> void {
+    std::ofstream file {path};
+    if (!file) {
+        throw std::runtime_error(fmt::format("Unable to open trace file '{}'", path));
+    }
+
+    std::string out;
+    auto it = std::back_inserter(out);
+
+    fmt::format_to(it, "{{\"traceEvents\": [\n");
+    auto phases = GetPhases();
+    for (const auto& phase : phases) {
+        fmt::format_to(
+            it, "{{\"name\": {}, \"ph\": \"X\", \"ts\": {}, \"dur\": {}, \"pid\": 1, \"tid\": {}}},\n"
+            , jsonString(phase.Name), phase.Start, phase.Duration, phase.Thread
+        );
+    }
+
+    fmt::format_to(it, "{{\"name\": \"counters\", \"ph\": \"C\", \"ts\": {}, \"pid\": 1, \"args\": {{", Now());
+    for (auto counter : counters()) {
+        fmt::format_to(it, "{}{}: {}", counter == counters().front() ? "" : ", ", jsonString(statsCounterName(counter)), GetCounter(counter));
+    }
+    fmt::format_to(it, "}}}}\n]}}\n");
+
+    file << out;
+    if (!file.flush()) {
+        throw std::runtime_error(fmt::format("Unable to write trace file '{}'", path));
+    }
+}
+
+} // namespace kimp::utils
@@ -0,0 +1,57 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cipher/affine.hpp>
+#include <math/binary.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+TEST_CASE ("Affine byte cipher kernels", "[affine]") {
+    auto kernel = GENERATE(
+        kimp::cipher::EAffineKernel::Scalar
+        , kimp::cipher::EAffineKernel::Ssse3
+        , kimp::cipher::EAffineKernel::Avx2
+        , kimp::cipher::EAffineKernel::Avx512
+    );
+    if (!kimp::cipher::isAffineKernelSupported(kernel)) {
+        return;
+    }
+
+    auto field = kimp::math::TGaluaBinaryArithmetic {kimp::math::TPolynomial<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1}, 8};
+    std::mt19937 rng {static_cast<unsigned>(kernel)};
+
+    for (std::size_t size : {0, 1, 15, 16, 17, 63, 64, 65, 255, 256, 1000, 4099}) {
+        std::byte a {static_cast<unsigned char>(rng() % 255 + 1)}, b {static_cast<unsigned char>(rng())};
+        auto cipher = kimp::cipher::TAffineByteCipher {a, b, kernel};
+        REQUIRE(cipher.GetKernel() == kernel);
+
+        std::vector<std::byte> open (size), closed (size), restored (size);
+        for (auto& e : open) e = std::byte(rng());
+
+        cipher.Encode(open, closed);
+        cipher.Decode(closed, restored);
+        REQUIRE(restored == open);
+
+        for (std::size_t i {0}; i < size; i++) {
+            kimp::math::TGaluaBinaryArithmetic::TElement x {}, ka {};
+            x[0] = static_cast<ui64>(open[i]);
+            ka[0] = static_cast<ui64>(a);
+            REQUIRE(static_cast<ui64>(closed[i]) == (field.Mul(ka, x)[0] ^ static_cast<ui64>(b)));
+        }
+    }
+}
+
+TEST_CASE ("Affine byte cipher rejects degenerate keys", "[affine]") {
+    REQUIRE_THROWS(kimp::cipher::TAffineByteCipher {std::byte {0}, std::byte {1}});
+
+    auto cipher = kimp::cipher::TAffineByteCipher {std::byte {3}, std::byte {1}};
+    std::vector<std::byte> in (10), out (9);
+    REQUIRE_THROWS(cipher.Encode(in, out));
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <math/binary.hpp>
+#include <math/field.hpp>
+#include <math/operation.hpp>
+#include <math/rank.hpp>
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using TElement = kimp::math::TGaluaBinaryArithmetic::TElement;
+
+TEST_CASE ("Carry-less multiplication kernels", "[binary]") {
+    std::mt19937_64 rng {42};
+    auto hardware = kimp::math::selectCarrylessMulKernel();
+
+    for (std::size_t i {0}; i < 1000; i++) {
+        ui64 a = rng(), b = rng();
+
+        ui64 low {0}, high {0};
+        for (ui64 bit {0}; bit < 64; bit++) {
+            if ((b >> bit) & 1) {
+                low ^= a << bit;
+                high ^= bit ? a >> (64 - bit) : 0;
+            }
+        }
+
+        auto portable = kimp::math::clmulPortable(a, b);
+        REQUIRE(portable.Low == low);
+        REQUIRE(portable.High == high);
+
+        auto selected = hardware(a, b);
+        REQUIRE(selected.Low == low);
+        REQUIRE(selected.High == high);
+    }
+}
+
+TEST_CASE ("GF(2^8) matches polynomial arithmetic", "[binary]") {
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1});
+    auto binary = kimp::math::TGaluaBinaryArithmetic {*base, 8};
+    auto mul = kimp::math::TGaluaMulOperation<i64> {base, 2};
+
+    for (ui64 a {0}; a < 256; a++) {
+        auto pa = kimp::math::rankToPolynomial(a, 2);
+        REQUIRE(binary.Unpack(binary.Pack(pa)) == pa);
+
+        for (ui64 b {0}; b < 256; b++) {
+            auto pb = kimp::math::rankToPolynomial(b, 2);
+            REQUIRE(binary.Unpack(binary.Mul(binary.Pack(pa), binary.Pack(pb))) == mul.Apply(pa, pb));
+        }
+
+        if (a) {
+            REQUIRE(binary.Mul(binary.Pack(pa), binary.Inverse(binary.Pack(pa))) == binary.One());
+        }
+    }
+}
+
+TEST_CASE ("GF(2^571) field laws", "[binary]") {
+    std::vector<i64> coefficients (572, 0);
+    for (ui64 e : {571, 10, 5, 2, 0}) {
+        coefficients[571 - e] = 1;
+    }
+    auto binary = kimp::math::TGaluaBinaryArithmetic {kimp::math::TPolynomial<i64> {coefficients}, 571};
+
+    std::mt19937_64 rng {571};
+    auto random = [&] () {
+        TElement e {};
+        for (auto& w : e) w = rng();
+        e.back() &= (ui64 {1} << (571 % 64)) - 1;
+        return e;
+    };
+
+    for (std::size_t i {0}; i < 20; i++) {
+        auto a = random(), b = random(), c = random();
+
+        REQUIRE(binary.Mul(a, b) == binary.Mul(b, a));
+        REQUIRE(binary.Mul(binary.Mul(a, b), c) == binary.Mul(a, binary.Mul(b, c)));
+        REQUIRE(binary.Mul(binary.Sum(a, b), c) == binary.Sum(binary.Mul(a, c), binary.Mul(b, c)));
+        REQUIRE(binary.Mul(a, binary.Inverse(a)) == binary.One());
+    }
+}
+
+TEST_CASE ("GF(2^571) as a Galua field", "[binary]") {
+    std::vector<i64> coefficients (572, 0);
+    for (ui64 e : {571, 10, 5, 2, 0}) {
+        coefficients[571 - e] = 1;
+    }
+    auto field = kimp::math::TGaluaField {std::make_shared<kimp::math::TPolynomial<i64>>(coefficients), 2, 571};
+
+    // 2^571 elements have no ranks, arithmetic goes through the packed words
+    REQUIRE_FALSE(field.IsIndexed());
+    REQUIRE(field.GetBinaryArithmetic());
+    REQUIRE_THROWS_AS(field.Size(), std::logic_error);
+    REQUIRE_THROWS_AS(field.At(1), std::logic_error);
+    REQUIRE_THROWS_AS(field.Order(kimp::math::TPolynomial<i64> {1, 0}), std::logic_error);
+
+    std::mt19937_64 rng {571};
+    auto random = [&] () {
+        TElement e {};
+        for (auto& w : e) w = rng();
+        e.back() &= (ui64 {1} << (571 % 64)) - 1;
+        return field.GetBinaryArithmetic()->Unpack(e);
+    };
+
+    auto mul = field.GetMulOperation();
+    auto sum = field.GetSumOperation();
+    auto one = kimp::math::TPolynomial<i64> {1};
+    for (std::size_t i {0}; i < 10; i++) {
+        auto a = random(), b = random();
+
+        REQUIRE(mul->Apply(a, field.Inverse(a)) == one);
+        REQUIRE(field.Pow(a, 3) == mul->Apply(mul->Apply(a, a), a));
+        REQUIRE(mul->Apply(sum->Apply(a, b), a) == sum->Apply(mul->Apply(a, a), mul->Apply(b, a)));
+    }
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
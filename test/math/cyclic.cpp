@@ -0,0 +1,162 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/cyclic.hpp>
+#include <math/field.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+TEST_CASE ("Generators of F*", "[cyclic]") {
+    auto [p, n, coefficients] = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 1, std::vector<i64> {1, 1})
+        , std::make_tuple(2, 3, std::vector<i64> {1, 0, 1, 1})
+        , std::make_tuple(3, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(5, 2, std::vector<i64> {1, 1, 2})
+        , std::make_tuple(7, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(2, 8, std::vector<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1})
+    );
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(coefficients);
+
+    for (ui64 budget : {ui64 {0}, kimp::math::TGaluaField::DefaultLogTableMemoryBudget}) {
+        kimp::math::TGaluaField field {base, p, n, budget};
+        ui64 q = field.Size();
+
+        std::vector<ui64> expected;
+        for (ui64 rank {1}; rank < q; rank++) {
+            bool generator = field.Order(field.At(rank)) == q - 1;
+            REQUIRE(field.IsGenerator(field.At(rank)) == generator);
+            if (generator) {
+                expected.push_back(rank);
+            }
+        }
+        REQUIRE_FALSE(field.IsGenerator(field.At(0)));
+        REQUIRE(field.IsGenerator(field.FindGenerator()));
+
+        std::vector<ui64> generators;
+        auto all = field.AllGenerators();
+        for (auto it = all.begin(); it != all.end(); ++it) {
+            REQUIRE(*it == field.Pow(all.GetBase(), it.Exponent()));
+            generators.push_back(field.IndexOf(*it));
+        }
+        std::sort(generators.begin(), generators.end());
+        REQUIRE(generators == expected);
+    }
+}
+
+TEST_CASE ("Generator of a large field", "[cyclic]") {
+    // x^32 + x^22 + x^2 + x + 1, too large for a log table
+    std::vector<i64> coefficients32 (33, 0);
+    coefficients32[0] = coefficients32[10] = coefficients32[30] = coefficients32[31] = coefficients32[32] = 1;
+    kimp::math::TGaluaField field {std::make_shared<kimp::math::TPolynomial<i64>>(coefficients32), 2, 32};
+    REQUIRE(field.GetLogTable() == nullptr);
+
+    auto g = field.FindGenerator();
+    REQUIRE(field.IsGenerator(g));
+    REQUIRE(field.Order(g) == (ui64 {1} << 32) - 1);
+
+    auto generators = field.AllGenerators();
+    auto it = generators.begin();
+    REQUIRE(*it == g);
+    REQUIRE(it.Exponent() == 1);
+    for (int i {0}; i < 100; i++, ++it) {
+        REQUIRE(field.IsGenerator(*it));
+    }
+}
+
+TEST_CASE ("Generators over a reducible base", "[cyclic]") {
+    auto [p, n, coefficients] = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(3, 2, std::vector<i64> {1, 0, 2})
+        , std::make_tuple(2, 4, std::vector<i64> {1, 0, 1, 0, 1})
+    );
+    kimp::math::TGaluaField field {std::make_shared<kimp::math::TPolynomial<i64>>(coefficients), p, n};
+
+    // Nonzero elements don't form a group, x passes a^((q - 1) / r) != 1 all the same
+    auto x = kimp::math::TPolynomial<i64> {1, 0};
+    REQUIRE_THROWS_AS(field.IsGenerator(x), std::logic_error);
+    REQUIRE_THROWS_AS(field.FindGenerator(), std::logic_error);
+    REQUIRE_THROWS_AS(field.AllGenerators(), std::logic_error);
+    REQUIRE_THROWS_AS(field.Subgroups(), std::logic_error);
+    REQUIRE_THROWS_AS(field.Subgroup(1), std::logic_error);
+    REQUIRE_THROWS_AS(field.Order(x), std::logic_error);
+}
+
+TEST_CASE ("Subgroup lattice of F*", "[cyclic]") {
+    auto [p, n, coefficients] = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 1, std::vector<i64> {1, 1})
+        , std::make_tuple(3, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(7, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(2, 8, std::vector<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1})
+    );
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(coefficients);
+    kimp::math::TGaluaField field {base, p, n};
+    ui64 q = field.Size();
+
+    auto subgroups = field.Subgroups();
+    auto groups = field.GroupByOrder();
+    REQUIRE(subgroups.size() == groups.size());
+    REQUIRE(subgroups.front().GetOrder() == 1);
+    REQUIRE(subgroups.back().GetOrder() == q - 1);
+
+    for (const auto& subgroup : subgroups) {
+        ui64 d = subgroup.GetOrder();
+        REQUIRE(field.Order(subgroup.GetGenerator()) == d);
+
+        // The only subgroup of order d holds every element which order divides d
+        std::vector<ui64> elements, expected;
+        for (const auto& e : subgroup.GetElements()) {
+            elements.push_back(field.IndexOf(e));
+        }
+        for (const auto& [order, ranks] : groups) {
+            if (d % order == 0) {
+                expected.insert(expected.end(), ranks.begin(), ranks.end());
+            }
+        }
+        std::sort(elements.begin(), elements.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(elements == expected);
+
+        std::vector<ui64> generators;
+        for (const auto& e : subgroup.GetGenerators()) {
+            generators.push_back(field.IndexOf(e));
+        }
+        std::sort(generators.begin(), generators.end());
+        REQUIRE(generators == groups.at(d));
+
+        REQUIRE(field.Subgroup(d).GetGenerator() == subgroup.GetGenerator());
+    }
+    REQUIRE_THROWS(field.Subgroup(q));
+    REQUIRE_THROWS(field.Subgroup(0));
+}
+
+TEST_CASE ("Subgroups of a large field", "[cyclic]") {
+    // x^32 + x^22 + x^2 + x + 1, q - 1 = 3 * 5 * 17 * 257 * 65537
+    std::vector<i64> coefficients (33, 0);
+    coefficients[0] = coefficients[10] = coefficients[30] = coefficients[31] = coefficients[32] = 1;
+    kimp::math::TGaluaField field {std::make_shared<kimp::math::TPolynomial<i64>>(coefficients), 2, 32};
+
+    auto subgroups = field.Subgroups();
+    REQUIRE(subgroups.size() == 32);
+    for (std::size_t i {0}; i < 5; i++) {
+        const auto& subgroup = subgroups[i];
+        ui64 size {0};
+        for (const auto& e : subgroup.GetElements()) {
+            REQUIRE(subgroup.GetOrder() % field.Order(e) == 0);
+            size++;
+        }
+        REQUIRE(size == subgroup.GetOrder());
+    }
+    REQUIRE(subgroups[4].GetOrder() == 17);
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
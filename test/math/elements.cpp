@@ -0,0 +1,65 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <math/elements.hpp>
+#include <math/field.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+static_assert(std::ranges::random_access_range<kimp::math::TGaluaElementView>);
+static_assert(std::ranges::sized_range<kimp::math::TGaluaElementView>);
+static_assert(std::ranges::view<kimp::math::TGaluaElementView>);
+
+TEST_CASE ("Lazy element view", "[elements]") {
+    auto view = kimp::math::TGaluaElementView {3, 27};
+
+    REQUIRE(view.size() == 27);
+    REQUIRE(std::ranges::distance(view) == 27);
+    REQUIRE(view[5] == kimp::math::TPolynomial<i64> {1, 2});
+    REQUIRE(*(view.end() - 1) == kimp::math::TPolynomial<i64> {2, 2, 2});
+    REQUIRE(std::ranges::find(view, kimp::math::TPolynomial<i64> {1, 0, 0}) - view.begin() == 9);
+    REQUIRE_THROWS(view.at(27));
+
+    auto set = kimp::math::TGaluaElementSet {3, 3, 27};
+    for (const auto& e : view) {
+        REQUIRE(set.contains(e));
+    }
+    REQUIRE_FALSE(set.contains(kimp::math::TPolynomial<i64> {1, 0, 0, 0}));
+    REQUIRE_FALSE(set.contains(kimp::math::TPolynomial<i64> {3}));
+    REQUIRE_FALSE(set.contains(kimp::math::TPolynomial<i64> {-1, 1}));
+}
+
+TEST_CASE ("Large fields are not materialized", "[elements]") {
+    std::vector<i64> binaryBase (33, 0);
+    for (ui64 e : {32, 22, 2, 1, 0}) {
+        binaryBase[32 - e] = 1;
+    }
+    std::vector<i64> ternaryBase (21, 0);
+    ternaryBase[0] = 1;
+    ternaryBase[15] = 1;
+    ternaryBase[20] = 2;
+
+    for (auto [p, n, base] : {std::make_tuple(ui64 {2}, ui64 {32}, binaryBase), std::make_tuple(ui64 {3}, ui64 {20}, ternaryBase)}) {
+        auto field = kimp::math::TGaluaField {std::make_shared<kimp::math::TPolynomial<i64>>(base), p, n};
+
+        ui64 q {1};
+        for (ui64 i {0}; i < n; i++) q *= p;
+        REQUIRE(field.Size() == q);
+        REQUIRE(field.GetElements().size() == q);
+
+        auto one = kimp::math::TPolynomial<i64> {1};
+        for (ui64 rank : {ui64 {1}, ui64 {12345}, q / 3, q - 1}) {
+            auto e = field.GetElements()[rank];
+            REQUIRE(field.IndexOf(e) == rank);
+            REQUIRE(field.GetMulOperation()->Apply(e, field.Inverse(e)) == one);
+        }
+    }
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
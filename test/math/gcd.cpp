@@ -2,9 +2,15 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
+#include <math/field.hpp>
 #include <math/gcd.hpp>
+#include <math/rank.hpp>
 
+#include <memory>
+#include <numeric>
+#include <random>
 #include <tuple>
+#include <vector>
 
 TEST_CASE ("GCD calculating", "[gcd]") {
     auto testData = GENERATE(
@@ -38,6 +44,105 @@ TEST_CASE ("GCD calculating", "[gcd]") {
     }
 }
 
+TEST_CASE ("Binary and extended GCD on full range values", "[gcd]") {
+    std::mt19937_64 rng {2024};
+    for (int i {0}; i < 20000; i++) {
+        ui64 common = rng() >> (rng() % 64);
+        ui64 a = (rng() >> (rng() % 64)) * (common | 1), b = (rng() >> (rng() % 64)) * (common | 1);
+        REQUIRE(kimp::math::gcd(a, b) == std::gcd(a, b));
+
+        auto [g, x, y] = kimp::math::gcdExtended(a, b);
+        REQUIRE(g == std::gcd(a, b));
+        REQUIRE(static_cast<ui64>(x) * a + static_cast<ui64>(y) * b == g);
+
+        i64 sa = static_cast<i64>(rng()) >> (rng() % 64), sb = static_cast<i64>(rng()) >> (rng() % 64);
+        auto [sg, sx, sy] = kimp::math::gcdExtended(sa, sb);
+        REQUIRE(kimp::math::gcd(sa, sb) == sg);
+        REQUIRE(static_cast<ui64>(sg) == std::gcd(kimp::math::NPrivate::magnitude(sa), kimp::math::NPrivate::magnitude(sb)));
+        REQUIRE(static_cast<ui64>(sx) * static_cast<ui64>(sa) + static_cast<ui64>(sy) * static_cast<ui64>(sb) == static_cast<ui64>(sg));
+    }
+    REQUIRE(kimp::math::gcd(i32 {-12}, i32 {18}) == 6);
+    REQUIRE(kimp::math::gcd(~ui64 {0}, ~ui64 {0} - 2) == 1);
+}
+
+TEST_CASE ("Modular inverses", "[gcd]") {
+    auto n = GENERATE(ui64 {2}, ui64 {7}, ui64 {1000000007}, (ui64 {1} << 61) - 1, ~ui64 {0}, ui64 {18446744073709551557ull});
+    kimp::math::TBarrett mod {n};
+
+    std::mt19937_64 rng {n};
+    std::vector<ui64> values;
+    while (values.size() < 1000) {
+        ui64 v = rng() % n;
+        if (std::gcd(v, n) == 1) {
+            values.push_back(v);
+        }
+    }
+
+    for (ui64 v : values) {
+        REQUIRE(mod.Mul(v, kimp::math::modInverse(v, n)) == 1 % n);
+    }
+    REQUIRE(kimp::math::modInverse(i64 {-1}, n) == n - 1);
+    REQUIRE_THROWS(kimp::math::modInverse(0, n));
+    REQUIRE_THROWS(kimp::math::modInverse(3, 0));
+
+    auto inverses = kimp::math::batchModInverse(values, n);
+    for (std::size_t i {0}; i < values.size(); i++) {
+        REQUIRE(inverses[i] == kimp::math::modInverse(values[i], n));
+    }
+    values.push_back(0);
+    REQUIRE_THROWS(kimp::math::batchModInverse(values, n));
+    REQUIRE(kimp::math::batchModInverse({}, n).empty());
+}
+
+TEST_CASE ("Polynomial GCD and batched inverses", "[gcd]") {
+    using TPolynomial = kimp::math::TPolynomial<i64>;
+
+    // (x + 1)(x + 2) and (x + 1)(x + 3) over GF(5)
+    REQUIRE(kimp::math::polynomialGcd(TPolynomial {1, 3, 2}, TPolynomial {2, 3, 1}, 5) == TPolynomial {1, 1});
+    REQUIRE(kimp::math::polynomialGcd(TPolynomial {1, 3, 2}, TPolynomial {1, 0, 2}, 5) == TPolynomial {1});
+    REQUIRE(kimp::math::polynomialGcd(TPolynomial {0}, TPolynomial {0}, 5) == TPolynomial {0});
+
+    // x^8 + x^4 + x^3 + x + 1
+    TPolynomial modulus {1, 0, 0, 0, 1, 1, 0, 1, 1};
+    std::vector<TPolynomial> values;
+    for (ui64 rank {1}; rank < 256; rank++) {
+        values.push_back(kimp::math::rankToPolynomial(rank, 2));
+    }
+    auto inverses = kimp::math::batchPolynomialModInverse<i64>(values, modulus, 2);
+    for (std::size_t i {0}; i < values.size(); i++) {
+        REQUIRE(inverses[i] == kimp::math::polynomialModInverse(values[i], modulus, 2));
+    }
+
+    values.push_back(modulus);
+    REQUIRE_THROWS(kimp::math::batchPolynomialModInverse<i64>(values, modulus, 2));
+}
+
+TEST_CASE ("Field inverse", "[gcd]") {
+    auto [p, n, base] = GENERATE(
+        std::make_tuple(ui64 {3}, ui64 {3}, std::vector<i64> {1, 0, 2, 1})
+        , std::make_tuple(ui64 {2}, ui64 {8}, std::vector<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1})
+        , std::make_tuple(ui64 {5}, ui64 {2}, std::vector<i64> {1, 1, 2})
+    );
+    auto basePolynomial = std::make_shared<kimp::math::TPolynomial<i64>>(base);
+
+    // Log table path, then Euclid (and binary exponentiation for p = 2) without it
+    for (ui64 budget : {kimp::math::TGaluaField::DefaultLogTableMemoryBudget, ui64 {0}}) {
+        kimp::math::TGaluaField field {basePolynomial, p, n, budget};
+        REQUIRE((field.GetLogTable() != nullptr) == (budget != 0));
+
+        auto one = kimp::math::TPolynomial<i64> {1};
+        for (const auto& e : field.GetElements()) {
+            if (e.isZero()) {
+                REQUIRE_THROWS(field.Inverse(e));
+                continue;
+            }
+            auto inverse = field.Inverse(e);
+            REQUIRE(field.GetMulOperation()->Apply(e, inverse) == one);
+            REQUIRE(kimp::math::polynomialModInverse(e, *basePolynomial, p) == inverse);
+        }
+    }
+}
+
 auto main(int argc, char ** argv) -> int {
     return Catch::Session().run(argc, argv);
 }
@@ -0,0 +1,75 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/irreducible.hpp>
+#include <math/prime.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace {
+
+// Every monic polynomial of degree n over GF(p)
+auto monicPolynomials(ui64 p, ui64 n) -> std::vector<kimp::math::TPolynomial<i64>> {
+    ui64 count {1};
+    for (ui64 i {0}; i < n; i++) count *= p;
+
+    std::vector<kimp::math::TPolynomial<i64>> result;
+    for (ui64 rank {0}; rank < count; rank++) {
+        std::vector<i64> coefficients (n + 1, 0);
+        coefficients[0] = 1;
+        for (ui64 k {n}, r {rank}; r; k--, r /= p) {
+            coefficients[k] = static_cast<i64>(r % p);
+        }
+        result.push_back(kimp::math::TPolynomial<i64> {coefficients});
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE ("Irreducible and primitive polynomials are counted right", "[irreducible]") {
+    // Gauss formula for irreducible ones, phi(p^n - 1) / n for primitive ones
+    auto [p, n, irreducible, primitive] = GENERATE(
+        std::make_tuple(ui64 {2}, ui64 {2}, 1, 1)
+        , std::make_tuple(ui64 {2}, ui64 {3}, 2, 2)
+        , std::make_tuple(ui64 {2}, ui64 {4}, 3, 2)
+        , std::make_tuple(ui64 {2}, ui64 {6}, 9, 6)
+        , std::make_tuple(ui64 {2}, ui64 {8}, 30, 16)
+        , std::make_tuple(ui64 {3}, ui64 {2}, 3, 2)
+        , std::make_tuple(ui64 {3}, ui64 {3}, 8, 4)
+        , std::make_tuple(ui64 {3}, ui64 {4}, 18, 8)
+        , std::make_tuple(ui64 {5}, ui64 {2}, 10, 4)
+    );
+
+    int irreducibleCount {0}, primitiveCount {0};
+    for (const auto& f : monicPolynomials(p, n)) {
+        irreducibleCount += kimp::math::isIrreducible(f, p);
+        primitiveCount += kimp::math::isPrimitive(f, p);
+    }
+    REQUIRE(irreducibleCount == irreducible);
+    REQUIRE(primitiveCount == primitive);
+}
+
+TEST_CASE ("Irreducibility of known polynomials", "[irreducible]") {
+    // x^4 + x^2 + 1 = (x^2 + x + 1)^2 has no roots in GF(2)
+    REQUIRE_FALSE(kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {1, 0, 1, 0, 1}, 2));
+    // x^2 + x + 1 over GF(5) is irreducible, but x^3 = 1 so x isn't primitive
+    REQUIRE(kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {1, 1, 1}, 5));
+    REQUIRE_FALSE(kimp::math::isPrimitive(kimp::math::TPolynomial<i64> {1, 1, 1}, 5));
+    // Non monic and negative coefficients: 2x^3 - x + 2 = 2 (x^3 + x + 1) over GF(3)
+    REQUIRE(kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {2, 0, -1, 2}, 3) == kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {1, 0, 1, 1}, 3));
+    REQUIRE_FALSE(kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {3, 1, 1}, 3));
+
+    std::vector<i64> aes {1, 0, 0, 0, 1, 1, 0, 1, 1};
+    REQUIRE(kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {aes}, 2));
+    REQUIRE_FALSE(kimp::math::isPrimitive(kimp::math::TPolynomial<i64> {aes}, 2));
+
+    REQUIRE(kimp::math::primeFactors(ui64 {360}) == std::vector<ui64> {2, 3, 5});
+    REQUIRE(kimp::math::primeFactors(ui64 {4294967295}) == std::vector<ui64> {3, 5, 17, 257, 65537});
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/field.hpp>
+#include <math/logtable.hpp>
+#include <math/rank.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+TEST_CASE ("Log table arithmetic", "[logtable]") {
+    auto testData = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 3, std::vector<i64> {1, 0, 1, 1})
+        , std::make_tuple(3, 2, std::vector<i64> {1, 1, 2})
+        , std::make_tuple(3, 3, std::vector<i64> {1, 0, 2, 1})
+        , std::make_tuple(5, 2, std::vector<i64> {1, 1, 2})
+    );
+
+    ui64 p, n;
+    std::vector<i64> coefficients;
+    std::tie(p, n, coefficients) = testData;
+
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(coefficients);
+    auto table = kimp::math::TGaluaLogTable::TryBuild(*base, p, n);
+    REQUIRE(table);
+
+    auto q = table->Size();
+    auto sum = kimp::math::TGaluaSumOperation<i64> {static_cast<i64>(p)};
+    auto mul = kimp::math::TGaluaMulOperation<i64> {base, static_cast<i64>(p)};
+
+    SECTION ("matches polynomial arithmetic") {
+        for (ui64 a {0}; a < q; a++) {
+            auto pa = kimp::math::rankToPolynomial(a, p);
+            REQUIRE(kimp::math::polynomialToRank(pa, p) == a);
+
+            for (ui64 b {0}; b < q; b++) {
+                auto pb = kimp::math::rankToPolynomial(b, p);
+                REQUIRE(kimp::math::rankToPolynomial(table->Sum(a, b), p) == sum.Apply(pa, pb));
+                REQUIRE(kimp::math::rankToPolynomial(table->Mul(a, b), p) == mul.Apply(pa, pb));
+            }
+        }
+    }
+
+    SECTION ("division, inverse and power") {
+        for (ui64 a {1}; a < q; a++) {
+            REQUIRE(table->Mul(a, table->Inverse(a)) == 1);
+            REQUIRE(table->Pow(a, q - 1) == 1);
+            REQUIRE(table->Pow(a, 2) == table->Mul(a, a));
+            for (ui64 b {1}; b < q; b++) {
+                REQUIRE(table->Mul(table->Div(a, b), b) == a);
+            }
+        }
+        REQUIRE(table->Pow(0, 0) == 1);
+        REQUIRE_THROWS(table->Inverse(0));
+    }
+}
+
+TEST_CASE ("Log table for a reducible base", "[logtable]") {
+    auto base = kimp::math::TPolynomial<i64> {1, 0, 1, 0, 1};
+    REQUIRE_FALSE(kimp::math::TGaluaLogTable::TryBuild(base, 2, 4));
+}
+
+TEST_CASE ("Orders over a reducible base", "[logtable]") {
+    // x^4 + x^2 + 1 = (x^2 + x + 1)^2 over GF(2) goes through the binary
+    // arithmetic, x^2 - 1 over GF(3) through the packed words
+    auto [p, n, coefficients] = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 4, std::vector<i64> {1, 0, 1, 0, 1})
+        , std::make_tuple(3, 2, std::vector<i64> {1, 0, 2})
+    );
+    kimp::math::TGaluaField field {std::make_shared<kimp::math::TPolynomial<i64>>(coefficients), p, n};
+    REQUIRE_FALSE(field.GetLogTable());
+
+    // Zero divisors have no order, and units are refused as well: there are 12
+    // of them in F2[x]/(x^4 + x^2 + 1), so orders dividing q - 1 = 15 are wrong
+    auto zeroDivisor = p == 2 ? kimp::math::TPolynomial<i64> {1, 1, 1} : kimp::math::TPolynomial<i64> {1, 1};
+    REQUIRE_THROWS_AS(field.Order(zeroDivisor), std::logic_error);
+    REQUIRE_THROWS_AS(field.Order(kimp::math::TPolynomial<i64> {1, 0}), std::logic_error);
+    REQUIRE_THROWS_AS(field.GroupByOrder(1), std::logic_error);
+    REQUIRE_THROWS_AS(field.GroupByOrder(4), std::logic_error);
+}
+
+TEST_CASE ("Field picks log table by memory budget", "[logtable]") {
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {1, 0, 2, 1});
+
+    REQUIRE(kimp::math::TGaluaField {base, 3, 3}.GetLogTable());
+    REQUIRE_FALSE(kimp::math::TGaluaField {base, 3, 3, 0}.GetLogTable());
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
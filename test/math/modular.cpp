@@ -0,0 +1,85 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/deduction.hpp>
+#include <math/gcd.hpp>
+#include <math/irreducible.hpp>
+#include <math/modular.hpp>
+
+#include <random>
+#include <vector>
+
+TEST_CASE ("Barrett reduction matches 128-bit division", "[modular]") {
+    auto n = GENERATE(
+        ui64 {1}, ui64 {2}, ui64 {3}, ui64 {65537}
+        , ui64 {4294967291}, ui64 {4294967296}, ui64 {4294967297}
+        , (ui64 {1} << 61) - 1, ui64 {18446744073709551557ull}, ~ui64 {0}
+    );
+    kimp::math::TBarrett mod {n};
+
+    std::mt19937_64 rng {n};
+    for (int i {0}; i < 10000; i++) {
+        ui64 a = rng() % n, b = rng() % n, c = rng() % n;
+        REQUIRE(mod.Mul(a, b) == static_cast<ui64>(static_cast<ui128>(a) * b % n));
+        REQUIRE(mod.MulAdd(a, b, c) == static_cast<ui64>((static_cast<ui128>(a) * b + c) % n));
+        REQUIRE(mod.Add(a, b) == static_cast<ui64>((static_cast<ui128>(a) + b) % n));
+        REQUIRE(mod.Add(mod.Sub(a, b), b) == a);
+        REQUIRE(mod.Add(a, mod.Neg(a)) == 0);
+    }
+    REQUIRE(mod.Mul(n - 1, n - 1) == (n == 1 ? 0 : 1));
+    REQUIRE_THROWS(kimp::math::TBarrett {0});
+}
+
+TEST_CASE ("Montgomery form round trip", "[modular]") {
+    ui64 p = (ui64 {1} << 61) - 1;
+    kimp::math::TMontgomery mont {p};
+    kimp::math::TBarrett mod {p};
+
+    std::mt19937_64 rng {61};
+    for (int i {0}; i < 10000; i++) {
+        ui64 a = rng() % p, b = rng() % p;
+        REQUIRE(mont.From(mont.To(a)) == a);
+        REQUIRE(mont.From(mont.Mul(mont.To(a), mont.To(b))) == mod.Mul(a, b));
+    }
+    REQUIRE(mont.From(mont.Pow(mont.To(3), p - 1)) == 1);
+    REQUIRE(mod.Pow(3, p - 1) == 1);
+}
+
+TEST_CASE ("Deduction classes modulo a 61-bit prime", "[modular]") {
+    ui64 p = (ui64 {1} << 61) - 1;
+    kimp::math::TDeductionClass<ui64> a {p - 2, p}, b {p - 3, p};
+
+    // (-2) * (-3) = 6 and -2 + -3 = -5, a 64-bit product would overflow
+    REQUIRE(a * b == kimp::math::TDeductionClass<ui64> {6, p});
+    REQUIRE(a + b == kimp::math::TDeductionClass<ui64> {p - 5, p});
+    REQUIRE(-a == kimp::math::TDeductionClass<ui64> {2, p});
+    REQUIRE((a * b).GetN() == p);
+
+    kimp::math::TDeductionClass<ui64> big {~ui64 {0} - 1, ~ui64 {0}};
+    REQUIRE(big + big == kimp::math::TDeductionClass<ui64> {~ui64 {0} - 2, ~ui64 {0}});
+    REQUIRE(big * big == kimp::math::TDeductionClass<ui64> {1, ~ui64 {0}});
+    REQUIRE_THROWS(kimp::math::TDeductionClass<ui64> {5, 5});
+
+    kimp::math::TDeductionClass<ui32> small {4294967290u, 4294967291u};
+    REQUIRE(small * small == kimp::math::TDeductionClass<ui32> {1, 4294967291u});
+}
+
+TEST_CASE ("Polynomial arithmetic over a 61-bit prime field", "[modular]") {
+    i64 p = (i64 {1} << 61) - 1;
+    // x^2 - 3 is irreducible since 3 isn't a square modulo 2^61 - 1
+    auto modulus = kimp::math::TPolynomial<i64> {1, 0, p - 3};
+    REQUIRE(kimp::math::isIrreducible(modulus, static_cast<ui64>(p)));
+    REQUIRE_FALSE(kimp::math::isIrreducible(kimp::math::TPolynomial<i64> {1, 0, p - 4}, static_cast<ui64>(p)));
+
+    auto a = kimp::math::TPolynomial<i64> {p - 1, 12345};
+    auto inverse = kimp::math::polynomialModInverse(a, modulus, static_cast<ui64>(p));
+
+    kimp::math::TPolynomialResidueRing ring {modulus, static_cast<ui64>(p)};
+    auto product = ring.Mul(kimp::math::NPrivate::toDigits(a, static_cast<ui64>(p)), kimp::math::NPrivate::toDigits(inverse, static_cast<ui64>(p)));
+    REQUIRE(product == ring.One());
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
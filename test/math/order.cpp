@@ -0,0 +1,83 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/field.hpp>
+#include <math/gcd.hpp>
+#include <math/prime.hpp>
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+auto eulerPhi(ui64 n) -> ui64 {
+    ui64 phi {n};
+    for (ui64 r : kimp::math::primeFactors(n)) {
+        phi = phi / r * (r - 1);
+    }
+    return phi;
+}
+
+} // namespace
+
+TEST_CASE ("Element orders match repeated multiplication", "[order]") {
+    auto [p, n, coefficients] = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 3, std::vector<i64> {1, 0, 1, 1})
+        , std::make_tuple(3, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(3, 3, std::vector<i64> {1, 0, 2, 1})
+        , std::make_tuple(5, 2, std::vector<i64> {1, 1, 2})
+        , std::make_tuple(7, 2, std::vector<i64> {1, 0, 1})
+        , std::make_tuple(2, 8, std::vector<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1})
+    );
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(coefficients);
+
+    // Without a log table orders come from powers over the prime divisors of q - 1
+    for (ui64 budget : {ui64 {0}, kimp::math::TGaluaField::DefaultLogTableMemoryBudget}) {
+        kimp::math::TGaluaField field {base, p, n, budget};
+        REQUIRE((field.GetLogTable() != nullptr) == (budget != 0));
+
+        for (ui64 rank {1}; rank < field.Size(); rank++) {
+            auto a = field.At(rank);
+            auto power = a;
+            ui64 expected {1};
+            while (!(power.Degree() == 0 && power[0] == 1)) {
+                power = field.GetMulOperation()->Apply(power, a);
+                expected++;
+            }
+            REQUIRE(field.Order(a) == expected);
+            REQUIRE(field.Pow(a, expected) == kimp::math::TPolynomial<i64> {1});
+        }
+        REQUIRE_THROWS(field.Order(field.At(0)));
+        REQUIRE(field.Pow(field.At(0), 0) == kimp::math::TPolynomial<i64> {1});
+    }
+}
+
+TEST_CASE ("Grouping F* by order", "[order]") {
+    auto budget = GENERATE(ui64 {0}, kimp::math::TGaluaField::DefaultLogTableMemoryBudget);
+
+    // x^16 + x^12 + x^3 + x + 1
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1});
+    kimp::math::TGaluaField field {base, 2, 16, budget};
+
+    auto groups = field.GroupByOrder(4);
+    REQUIRE(groups == field.GroupByOrder(1));
+
+    // F* is cyclic of order 65535 = 3 * 5 * 17 * 257, so there are phi(d)
+    // elements of order d for every divisor d
+    ui64 total {0};
+    for (const auto& [order, ranks] : groups) {
+        REQUIRE(65535 % order == 0);
+        REQUIRE(ranks.size() == eulerPhi(order));
+        total += ranks.size();
+    }
+    REQUIRE(total == 65535);
+    REQUIRE(groups.size() == 16);
+    REQUIRE(groups.at(1) == std::vector<ui64> {1});
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/field.hpp>
+#include <math/operation.hpp>
+#include <math/packed.hpp>
+#include <math/rank.hpp>
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+TEST_CASE ("Packed element arithmetic", "[packed]") {
+    auto testData = GENERATE(
+        as<std::tuple<ui64, ui64, std::vector<i64>>>{}
+        , std::make_tuple(2, 3, std::vector<i64> {1, 0, 1, 1})
+        , std::make_tuple(3, 3, std::vector<i64> {1, 0, 2, 1})
+        , std::make_tuple(5, 2, std::vector<i64> {1, 1, 2})
+        , std::make_tuple(7, 2, std::vector<i64> {1, 0, 3})
+    );
+
+    ui64 p, n;
+    std::vector<i64> coefficients;
+    std::tie(p, n, coefficients) = testData;
+
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(coefficients);
+    auto packing = kimp::math::TGaluaPacking<ui64> {*base, p, n};
+
+    ui64 q {1};
+    for (ui64 i {0}; i < n; i++) q *= p;
+
+    auto sum = kimp::math::TGaluaSumOperation<i64> {static_cast<i64>(p)};
+    auto mul = kimp::math::TGaluaMulOperation<i64> {base, static_cast<i64>(p)};
+
+    for (ui64 a {0}; a < q; a++) {
+        auto pa = kimp::math::rankToPolynomial(a, p);
+        auto wa = packing.Pack(pa);
+
+        REQUIRE(packing.FromRank(a) == wa);
+        REQUIRE(packing.ToRank(wa) == a);
+        REQUIRE(packing.Unpack(wa) == pa);
+        REQUIRE(packing.Sum(wa, packing.Neg(wa)) == 0);
+
+        for (ui64 b {0}; b < q; b++) {
+            auto pb = kimp::math::rankToPolynomial(b, p);
+            auto wb = packing.Pack(pb);
+
+            REQUIRE((a < b) == (wa < wb));
+            REQUIRE(packing.Unpack(packing.Sum(wa, wb)) == sum.Apply(pa, pb));
+            REQUIRE(packing.Unpack(packing.Mul(wa, wb)) == mul.Apply(pa, pb));
+            REQUIRE(packing.Sum(packing.Sub(wa, wb), wb) == wa);
+        }
+    }
+}
+
+TEST_CASE ("Packed elements in 128-bit words", "[packed]") {
+    std::vector<i64> coefficients (43, 0);
+    coefficients[0] = coefficients[40] = coefficients[42] = 1;
+    auto base = kimp::math::TPolynomial<i64> {coefficients};
+
+    REQUIRE_FALSE(kimp::math::TGaluaPacking<ui64>::Fits(2, 42));
+    REQUIRE(kimp::math::TGaluaPacking<ui128>::Fits(2, 42));
+
+    auto packing = kimp::math::TGaluaPacking<ui128> {base, 2, 42};
+    auto a = packing.FromRank(0x123456789ABull), b = packing.FromRank(0x3FEDCBA9876ull), c = packing.FromRank(0x2468ACE0ull);
+
+    REQUIRE(packing.Mul(a, b) == packing.Mul(b, a));
+    REQUIRE(packing.Mul(packing.Mul(a, b), c) == packing.Mul(a, packing.Mul(b, c)));
+    REQUIRE(packing.Mul(packing.Sum(a, b), c) == packing.Sum(packing.Mul(a, c), packing.Mul(b, c)));
+    REQUIRE(packing.ToRank(packing.Sum(a, a)) == 0);
+}
+
+TEST_CASE ("Field element ranks", "[packed]") {
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {1, 0, 2, 1});
+    auto field = kimp::math::TGaluaField {base, 3, 3};
+    auto elements = field.GetElements();
+
+    REQUIRE(field.Size() == elements.size());
+    for (ui64 i {0}; i < field.Size(); i++) {
+        REQUIRE(field.At(i) == elements[i]);
+        REQUIRE(field.IndexOf(elements[i]) == i);
+    }
+    REQUIRE(field.IndexOf(kimp::math::TPolynomial<i64> {-1, 4}) == field.IndexOf(kimp::math::TPolynomial<i64> {2, 1}));
+
+    REQUIRE_THROWS(field.At(field.Size()));
+    REQUIRE_THROWS(field.IndexOf(kimp::math::TPolynomial<i64> {1, 0, 0, 0}));
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
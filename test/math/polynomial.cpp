@@ -0,0 +1,275 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/field.hpp>
+#include <math/polynomial.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> allocations {0};
+
+auto countedAlloc(std::size_t size, std::size_t alignment) -> void* {
+    allocations++;
+    size = size ? size : 1;
+    void* ptr = alignment > alignof(std::max_align_t)
+        ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+        : std::malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc {};
+    }
+    return ptr;
+}
+
+} // namespace
+
+// The whole family is replaced, so every new is paired with a free of our own
+auto operator new(std::size_t size) -> void* {
+    return countedAlloc(size, alignof(std::max_align_t));
+}
+
+auto operator new[](std::size_t size) -> void* {
+    return countedAlloc(size, alignof(std::max_align_t));
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void* {
+    return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new(std::size_t size, const std::nothrow_t&) noexcept -> void* {
+    try {
+        return countedAlloc(size, alignof(std::max_align_t));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t&) noexcept -> void* {
+    try {
+        return countedAlloc(size, alignof(std::max_align_t));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete[](void* ptr) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete[](void* ptr, std::size_t) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::align_val_t) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete[](void* ptr, std::align_val_t) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t, std::align_val_t) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept -> void {
+    std::free(ptr);
+}
+
+TEST_CASE ("Polynomial arithmetic", "[polynomial]") {
+    using TPolynomial = kimp::math::TPolynomial<i64>;
+
+    TPolynomial a {1, 2, 3}, b {-1, 0, 1};
+
+    REQUIRE(a + b == TPolynomial {std::vector<i64> {0, 2, 4}});
+    REQUIRE(a - TPolynomial {1, 0, 0} == TPolynomial {2, 3});
+    REQUIRE(a - a == TPolynomial {0});
+    REQUIRE(a * b == TPolynomial {-1, -2, -2, 2, 3});
+    REQUIRE(a * TPolynomial {0} == TPolynomial {0});
+    REQUIRE(a * 2 == TPolynomial {2, 4, 6});
+    REQUIRE(a % 2 == TPolynomial {1, 0, 1});
+    REQUIRE(TPolynomial {2, 4} % 2 == TPolynomial {0});
+    REQUIRE((a * b) % a == TPolynomial {0});
+    REQUIRE(TPolynomial {1, 0, 0, 1} % TPolynomial {1, 1} == TPolynomial {0});
+    REQUIRE(TPolynomial {1, 0, 1} % TPolynomial {1, 0, 0, 0} == TPolynomial {1, 0, 1});
+    REQUIRE(TPolynomial::one<i64>().Pow(3) == TPolynomial {1, 0, 0, 0});
+    REQUIRE(a[0] == 3);
+    REQUIRE(a[2] == 1);
+    REQUIRE_THROWS(a[3]);
+    REQUIRE(a.ToString() == "(1, 2, 3)");
+
+    auto c = a;
+    c += b;
+    c -= b;
+    REQUIRE(c == a);
+    c *= b;
+    REQUIRE(c == a * b);
+    c %= a;
+    REQUIRE(c.isZero());
+    REQUIRE(std::hash<TPolynomial> {}(a) == std::hash<TPolynomial> {}(TPolynomial {std::vector<i64> {1, 2, 3}}));
+}
+
+TEST_CASE ("Polynomials beyond inline storage", "[polynomial]") {
+    using TPolynomial = kimp::math::TPolynomial<i64>;
+
+    auto x = TPolynomial::one<i64>();
+    auto big = x.Pow(TPolynomial::InlineDegree * 3) + TPolynomial {1};
+    REQUIRE(big.Degree() == TPolynomial::InlineDegree * 3);
+
+    auto moved = std::move(big);
+    REQUIRE(moved[0] == 1);
+    REQUIRE(moved[TPolynomial::InlineDegree * 3] == 1);
+
+    auto product = moved * moved;
+    REQUIRE(product.Degree() == TPolynomial::InlineDegree * 6);
+    REQUIRE(product[TPolynomial::InlineDegree * 3] == 2);
+
+    auto small = TPolynomial {1, 1};
+    small = product;
+    REQUIRE(small == product);
+    small = TPolynomial {1, 1};
+    REQUIRE(small.Degree() == 1);
+    REQUIRE(product % moved == TPolynomial {0});
+}
+
+TEST_CASE ("Karatsuba and NTT products match schoolbook", "[polynomial]") {
+    auto [n, m] = GENERATE(
+        std::make_pair(std::size_t {1}, std::size_t {1})
+        , std::make_pair(std::size_t {3}, std::size_t {70})
+        , std::make_pair(std::size_t {64}, std::size_t {64})
+        , std::make_pair(std::size_t {100}, std::size_t {37})
+        , std::make_pair(std::size_t {257}, std::size_t {1000})
+    );
+
+    std::mt19937_64 rng {n * 1000 + m};
+    std::vector<i64> a (n), b (m);
+    std::vector<i32> a32 (n), b32 (m);
+    for (std::size_t i {0}; i < n; i++) {
+        a[i] = static_cast<i64>(rng());
+        a32[i] = static_cast<i32>(rng());
+    }
+    for (std::size_t i {0}; i < m; i++) {
+        b[i] = static_cast<i64>(rng());
+        b32[i] = static_cast<i32>(rng());
+    }
+    // Full range coefficients overflow, every algorithm has to wrap the same way
+    std::vector<i64> expected (n + m - 1), product (n + m - 1);
+    std::vector<i32> expected32 (n + m - 1), product32 (n + m - 1);
+    kimp::math::NPrivate::schoolbookMul<i64>(a, b, expected);
+    kimp::math::NPrivate::schoolbookMul<i32>(a32, b32, expected32);
+
+    auto saved = kimp::math::polynomialMulThresholds;
+    for (auto thresholds : {kimp::math::TPolynomialMulThresholds {2, 1ul << 40}, kimp::math::TPolynomialMulThresholds {2, 1}}) {
+        kimp::math::polynomialMulThresholds = thresholds;
+        kimp::math::NPrivate::polynomialMul<i64>(a, b, product);
+        kimp::math::NPrivate::polynomialMul<i32>(a32, b32, product32);
+        REQUIRE(product == expected);
+        REQUIRE(product32 == expected32);
+    }
+
+    auto x = kimp::math::TPolynomial<i64> {std::vector<i64> (a.rbegin(), a.rend())};
+    auto y = kimp::math::TPolynomial<i64> {std::vector<i64> (b.rbegin(), b.rend())};
+    kimp::math::polynomialMulThresholds = {8, 16};
+    auto xy = x * y;
+    kimp::math::polynomialMulThresholds = saved;
+    REQUIRE(xy == kimp::math::TPolynomial<i64> {std::vector<i64> (expected.rbegin(), expected.rend())});
+}
+
+TEST_CASE ("Polynomial evaluation", "[polynomial]") {
+    // 3x^3 - 2x + 7 is exact far beyond the 53 bits of a double
+    auto f = kimp::math::TPolynomial<i64> {3, 0, -2, 7};
+    REQUIRE(f.Calc(2) == 27);
+    REQUIRE(f.Calc(-1) == 6);
+    REQUIRE(f.Calc(1000000) == 3000000000000000000 - 2000000 + 7);
+    // Overflow wraps modulo 2^64: x^2 + 1 at 2^32 is 1
+    REQUIRE(kimp::math::TPolynomial<i64> {1, 0, 1}.Calc(i64 {1} << 32) == 1);
+    REQUIRE(kimp::math::TPolynomial<i64> {-1, 0}.Calc(std::numeric_limits<i64>::min()) == std::numeric_limits<i64>::min());
+    REQUIRE(f.CalcMod(1000000, 1000000007) == static_cast<ui64>((3000000000000000000 - 2000000 + 7) % 1000000007));
+
+    ui64 p = (ui64 {1} << 61) - 1;
+    // (p - 1)^3 = -1, so f(p - 1) = -3 + 2 + 7
+    REQUIRE(f.CalcMod(p - 1, p) == 6);
+    REQUIRE(f.CalcMod(p - 1 + p, p) == 6);
+}
+
+TEST_CASE ("Multipoint evaluation matches Horner", "[polynomial]") {
+    auto [degree, count, p] = GENERATE(
+        std::make_tuple(std::size_t {0}, std::size_t {5}, ui64 {7})
+        , std::make_tuple(std::size_t {5}, std::size_t {13}, ui64 {13})
+        , std::make_tuple(std::size_t {40}, std::size_t {300}, ui64 {65537})
+        , std::make_tuple(std::size_t {300}, std::size_t {1000}, (ui64 {1} << 61) - 1)
+        , std::make_tuple(std::size_t {700}, std::size_t {200}, ~ui64 {0})
+    );
+
+    std::mt19937_64 rng {degree * 1000 + count};
+    std::vector<i64> coefficients (degree + 1);
+    for (auto& c : coefficients) {
+        c = static_cast<i64>(rng());
+    }
+    coefficients[0] = coefficients[0] ? coefficients[0] : 1;
+    kimp::math::TPolynomial<i64> f {coefficients};
+
+    std::vector<ui64> points (count);
+    for (auto& x : points) {
+        x = rng();
+    }
+    std::vector<ui64> expected;
+    for (ui64 x : points) {
+        expected.push_back(f.CalcMod(x, p));
+    }
+
+    REQUIRE(f.EvaluateAll(points, p) == expected);
+
+    // Forces the subproduct tree and NTT products on small inputs
+    auto saved = kimp::math::polynomialEvalThresholds;
+    kimp::math::polynomialEvalThresholds = {1, 4};
+    auto values = f.EvaluateAll(points, p);
+    kimp::math::polynomialEvalThresholds = saved;
+    REQUIRE(values == expected);
+}
+
+TEST_CASE ("Field multiplication doesn't allocate", "[polynomial]") {
+    auto [p, n, base, budget] = GENERATE(
+        std::make_tuple(ui64 {3}, ui64 {3}, std::vector<i64> {1, 0, 2, 1}, ui64 {0})
+        , std::make_tuple(ui64 {3}, ui64 {4}, std::vector<i64> {1, 0, 0, 1, 2}, ui64 {0})
+        , std::make_tuple(ui64 {5}, ui64 {3}, std::vector<i64> {1, 0, 1, 1}, kimp::math::TGaluaField::DefaultLogTableMemoryBudget)
+        , std::make_tuple(ui64 {2}, ui64 {8}, std::vector<i64> {1, 0, 0, 0, 1, 1, 0, 1, 1}, ui64 {0})
+    );
+    kimp::math::TGaluaField field {std::make_shared<kimp::math::TPolynomial<i64>>(base), p, n, budget};
+    auto mul = field.GetMulOperation();
+    auto sum = field.GetSumOperation();
+
+    auto a = field.At(field.Size() - 1), b = field.At(field.Size() / 2 + 1);
+    auto before = allocations.load();
+    auto c = mul->Apply(a, b);
+    for (int i {0}; i < 100; i++) {
+        c = sum->Apply(mul->Apply(c, a), b);
+    }
+    REQUIRE(allocations.load() == before);
+    REQUIRE(field.IndexOf(c) < field.Size());
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
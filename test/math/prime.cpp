@@ -0,0 +1,93 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/prime.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+auto trialDivision(ui64 n) -> bool {
+    if (n < 2) {
+        return false;
+    }
+    for (ui64 i {2}; i * i <= n; i++) {
+        if (n % i == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE ("Primality of small numbers", "[prime]") {
+    REQUIRE_FALSE(kimp::math::isPrime(ui64 {0}));
+    REQUIRE_FALSE(kimp::math::isPrime(ui64 {1}));
+    REQUIRE_FALSE(kimp::math::isPrime(ui32 {0}));
+    REQUIRE_FALSE(kimp::math::isPrime(ui32 {1}));
+
+    for (ui64 n {0}; n < 200000; n++) {
+        REQUIRE(kimp::math::isPrime(n) == trialDivision(n));
+    }
+    REQUIRE(kimp::math::smallPrimes().size() == 6542);
+    REQUIRE(kimp::math::smallPrimes().back() == 65521);
+}
+
+TEST_CASE ("Primality of 64-bit numbers", "[prime]") {
+    auto [n, prime] = GENERATE(
+        std::make_pair((ui64 {1} << 61) - 1, true)
+        , std::make_pair((ui64 {1} << 31) - 1, true)
+        , std::make_pair(ui64 {18446744073709551557ull}, true)
+        , std::make_pair(ui64 {4179340454199820289ull}, true)
+        , std::make_pair(ui64 {1000000007}, true)
+        , std::make_pair(~ui64 {0}, false)
+        , std::make_pair((ui64 {1} << 59) - 1, false)
+        // Carmichael numbers and strong pseudoprimes to the first prime bases
+        , std::make_pair(ui64 {561}, false)
+        , std::make_pair(ui64 {3215031751}, false)
+        , std::make_pair(ui64 {3825123056546413051ull}, false)
+        , std::make_pair(ui64 {4294967291} * 4294967279, false)
+        , std::make_pair(ui64 {1000000007} * 1000000007, false)
+    );
+    REQUIRE(kimp::math::isPrime(n) == prime);
+}
+
+TEST_CASE ("Segmented sieve", "[prime]") {
+    auto [from, to] = GENERATE(
+        std::make_pair(ui64 {0}, ui64 {100000})
+        , std::make_pair(ui64 {65000}, ui64 {140000})
+        , std::make_pair(ui64 {1} << 40, (ui64 {1} << 40) + 100000)
+        , std::make_pair(ui64 {1} << 40, (ui64 {1} << 40) + (1 << 21))
+        , std::make_pair(~ui64 {0} - 50000, ~ui64 {0})
+        , std::make_pair(ui64 {17}, ui64 {17})
+    );
+
+    std::vector<ui64> expected;
+    for (ui64 n {from}; n < to; n++) {
+        if (kimp::math::isPrime(n)) {
+            expected.push_back(n);
+        }
+    }
+    REQUIRE(kimp::math::primesInRange(from, to) == expected);
+}
+
+TEST_CASE ("Factorization", "[prime]") {
+    using TFactors = std::vector<std::pair<ui64, ui64>>;
+
+    REQUIRE(kimp::math::factorize(ui64 {0}).empty());
+    REQUIRE(kimp::math::factorize(ui64 {1}).empty());
+    REQUIRE(kimp::math::factorize(ui64 {360}) == TFactors {{2, 3}, {3, 2}, {5, 1}});
+    REQUIRE(kimp::math::factorize(~ui64 {0}) == TFactors {{3, 1}, {5, 1}, {17, 1}, {257, 1}, {641, 1}, {65537, 1}, {6700417, 1}});
+    REQUIRE(kimp::math::factorize((ui64 {1} << 61) - 2) == TFactors {{2, 1}, {3, 2}, {5, 2}, {7, 1}, {11, 1}, {13, 1}, {31, 1}, {41, 1}, {61, 1}, {151, 1}, {331, 1}, {1321, 1}});
+    REQUIRE(kimp::math::factorize(ui64 {4294967291} * 4294967279) == TFactors {{4294967279, 1}, {4294967291, 1}});
+    REQUIRE(kimp::math::factorize(ui64 {1000000007} * 1000000007) == TFactors {{1000000007, 2}});
+    REQUIRE(kimp::math::factorize(ui64 {18446744073709551557ull}) == TFactors {{18446744073709551557ull, 1}});
+    REQUIRE(kimp::math::factorize(ui32 {4294967295}) == std::vector<std::pair<ui32, ui64>> {{3, 1}, {5, 1}, {17, 1}, {257, 1}, {65537, 1}});
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <math/deduction.hpp>
+#include <math/field.hpp>
+#include <math/operation.hpp>
+#include <math/polynomial.hpp>
+#include <math/rank.hpp>
+#include <math/set.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+TEST_CASE ("Hashed static set of polynomials", "[set]") {
+    std::vector<kimp::math::TPolynomial<i64>> elements;
+    for (ui64 rank {0}; rank < 1000; rank += 3) {
+        elements.push_back(kimp::math::rankToPolynomial(rank, 7));
+    }
+    auto set = kimp::math::TStaticSet<kimp::math::TPolynomial<i64>> {elements};
+
+    for (ui64 rank {0}; rank < 1000; rank++) {
+        REQUIRE(set.contains(kimp::math::rankToPolynomial(rank, 7)) == (rank % 3 == 0));
+    }
+
+    auto hash = std::hash<kimp::math::TPolynomial<i64>> {};
+    REQUIRE(hash(kimp::math::TPolynomial<i64> {1, 2, 3}) == hash(kimp::math::TPolynomial<i64> {std::vector<i64> {1, 2, 3}}));
+}
+
+TEST_CASE ("Hashed static set of deduction classes", "[set]") {
+    std::vector<kimp::math::TDeductionClass<ui64>> elements;
+    for (ui64 a {0}; a < 11; a += 2) {
+        elements.push_back(kimp::math::TDeductionClass<ui64> {a, 11});
+    }
+    auto set = kimp::math::TStaticSet<kimp::math::TDeductionClass<ui64>> {elements};
+
+    for (ui64 a {0}; a < 11; a++) {
+        REQUIRE(set.contains(kimp::math::TDeductionClass<ui64> {a, 11}) == (a % 2 == 0));
+    }
+    REQUIRE_FALSE(set.contains(kimp::math::TDeductionClass<ui64> {0, 13}));
+
+    auto empty = kimp::math::TStaticSet<kimp::math::TDeductionClass<ui64>> {std::vector<kimp::math::TDeductionClass<ui64>> {}};
+    REQUIRE_FALSE(empty.contains(kimp::math::TDeductionClass<ui64> {0, 13}));
+}
+
+TEST_CASE ("Closure verification", "[set]") {
+    using TClass = kimp::math::TDeductionClass<ui64>;
+
+    std::vector<TClass> all, partial;
+    for (ui64 a {0}; a < 211; a++) {
+        all.push_back(TClass {a, 211});
+        if (a != 100) partial.push_back(TClass {a, 211});
+    }
+    auto allSet = std::make_shared<kimp::math::TStaticSet<TClass>>(all);
+    auto partialSet = std::make_shared<kimp::math::TStaticSet<TClass>>(partial);
+    auto sum = std::make_shared<kimp::math::TSumOperation<TClass>>();
+
+    for (auto check : {kimp::math::EClosureCheck::Full, kimp::math::EClosureCheck::Sampled}) {
+        REQUIRE(sum->IsClosedFor(allSet, check));
+        REQUIRE_FALSE(sum->IsClosedFor(partialSet, check));
+    }
+
+    auto mul = std::make_shared<kimp::math::TMulOperation<TClass>>();
+    auto one = std::make_shared<kimp::math::TStaticSet<TClass>>(std::vector<TClass> {TClass {1, 211}});
+    REQUIRE(mul->IsClosedFor(one, kimp::math::EClosureCheck::Sampled));
+    REQUIRE(mul->IsClosedFor(one, kimp::math::EClosureCheck::Full));
+
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {1, 0, 2, 1});
+    auto field = kimp::math::TGaluaField {base, 3, 3};
+    auto packed = std::make_shared<kimp::math::TGaluaPackedSet<ui64>>(field.GetPacking(), std::vector<ui64> {0, 1, field.GetPacking()->FromRank(3)});
+    REQUIRE_FALSE(packed->IsComplete());
+    REQUIRE_FALSE(field.GetMulOperation()->IsClosedFor(packed, kimp::math::EClosureCheck::Full));
+    REQUIRE_FALSE(field.GetSumOperation()->IsClosedFor(packed, kimp::math::EClosureCheck::Full));
+
+    // 4x^2 + 3 over GF(5): integer long division by 4 leaves some products of degree 2
+    auto elements = std::make_shared<kimp::math::TGaluaElementSet>(5, 2, 25);
+    auto nonMonic = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {4, 0, 3});
+    REQUIRE_FALSE(std::make_shared<kimp::math::TGaluaMulOperation<i64>>(nonMonic, 5)->IsClosedFor(elements, kimp::math::EClosureCheck::Full));
+
+    // The field takes the monic x^2 + 2 instead
+    auto nonMonicField = kimp::math::TGaluaField {nonMonic, 5, 2, 0};
+    REQUIRE(nonMonicField.GetMulOperation()->IsClosedFor(elements, kimp::math::EClosureCheck::Full));
+    REQUIRE(nonMonicField.Order(kimp::math::TPolynomial<i64> {1, 0}) == 8);
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
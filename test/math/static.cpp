@@ -0,0 +1,78 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <math/field.hpp>
+#include <math/rank.hpp>
+#include <math/static.hpp>
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using TCipherField = kimp::math::GF<3, 3, 1, 0, 2, 1>;
+
+static_assert(TCipherField::Q == 27);
+static_assert(TCipherField::TElement {5} * TCipherField::Inverse(TCipherField::TElement {5}) == TCipherField::One());
+static_assert(TCipherField::Pow(TCipherField::TElement {3}, 26) == TCipherField::One());
+static_assert(TCipherField::TElement {7} - TCipherField::TElement {7} == TCipherField::Zero());
+
+TEST_CASE ("Compile time field matches polynomial arithmetic", "[static]") {
+    auto base = std::make_shared<kimp::math::TPolynomial<i64>>(std::vector<i64> {1, 0, 2, 1});
+    auto sum = kimp::math::TGaluaSumOperation<i64> {3};
+    auto mul = kimp::math::TGaluaMulOperation<i64> {base, 3};
+
+    for (ui64 a {0}; a < TCipherField::Q; a++) {
+        auto ea = TCipherField::TElement {a};
+        REQUIRE(ea.ToPolynomial() == kimp::math::rankToPolynomial(a, 3));
+        REQUIRE(TCipherField::TElement::FromPolynomial(ea.ToPolynomial()) == ea);
+
+        for (ui64 b {0}; b < TCipherField::Q; b++) {
+            auto eb = TCipherField::TElement {b};
+            REQUIRE((ea + eb).ToPolynomial() == sum.Apply(ea.ToPolynomial(), eb.ToPolynomial()));
+            REQUIRE((ea * eb).ToPolynomial() == mul.Apply(ea.ToPolynomial(), eb.ToPolynomial()));
+            REQUIRE(ea - eb + eb == ea);
+            if (!eb.isZero()) {
+                REQUIRE(ea / eb * eb == ea);
+            }
+        }
+    }
+    REQUIRE_THROWS(TCipherField::Inverse(TCipherField::Zero()));
+    REQUIRE_THROWS(TCipherField::TElement {27});
+    REQUIRE_THROWS(TCipherField::TElement::FromPolynomial(kimp::math::TPolynomial<i64> {1, 0, 0, 0}));
+}
+
+TEST_CASE ("Field dispatches to compile time tables", "[static]") {
+    auto [p, n, base, dispatched] = GENERATE(
+        std::make_tuple(ui64 {3}, ui64 {3}, std::vector<i64> {1, 0, 2, 1}, true)
+        // Same ideal as x^3 + 2x + 1
+        , std::make_tuple(ui64 {3}, ui64 {3}, std::vector<i64> {2, 0, 1, 2}, true)
+        , std::make_tuple(ui64 {3}, ui64 {2}, std::vector<i64> {2, 1, 1}, true)
+        , std::make_tuple(ui64 {2}, ui64 {4}, std::vector<i64> {1, 0, 0, 1, 1}, true)
+        , std::make_tuple(ui64 {3}, ui64 {3}, std::vector<i64> {1, 0, 2, 2}, false)
+        , std::make_tuple(ui64 {2}, ui64 {3}, std::vector<i64> {1, 1, 0, 1}, false)
+    );
+    auto basePolynomial = std::make_shared<kimp::math::TPolynomial<i64>>(base);
+
+    kimp::math::TGaluaField field {basePolynomial, p, n, 0};
+    REQUIRE((field.GetStaticTables() != nullptr) == dispatched);
+
+    auto sum = kimp::math::TGaluaSumOperation<i64> {static_cast<i64>(p)};
+    auto mul = kimp::math::TGaluaMulOperation<i64> {basePolynomial, static_cast<i64>(p)};
+
+    auto one = kimp::math::TPolynomial<i64> {1};
+    for (const auto& a : field.GetElements()) {
+        if (!a.isZero()) {
+            REQUIRE(field.GetMulOperation()->Apply(a, field.Inverse(a)) == one);
+            REQUIRE(kimp::math::polynomialModInverse(a, *basePolynomial, p) == field.Inverse(a));
+        }
+        for (const auto& b : field.GetElements()) {
+            REQUIRE(field.GetSumOperation()->Apply(a, b) == sum.Apply(a, b));
+            REQUIRE(field.GetMulOperation()->Apply(a, b) == mul.Apply(a, b));
+        }
+    }
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <utils/io.hpp>
+
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t ChunkSize = 4096;
+
+auto randomBytes(std::size_t size) -> std::vector<std::byte> {
+    std::mt19937 rng {42};
+    std::vector<std::byte> data (size);
+    for (auto& b : data) b = static_cast<std::byte>(rng());
+    return data;
+}
+
+// Catch assertions aren't thread safe, so the result is checked by the caller
+auto writeAll(int fd, std::span<const std::byte> data) -> bool {
+    while (!data.empty()) {
+        ssize_t written = ::write(fd, data.data(), data.size());
+        if (written <= 0) {
+            return false;
+        }
+        data = data.subspan(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+// Chunks are copied out at once, the spans may be reused by the next call
+auto readAll(kimp::utils::IChunkReader& reader) -> std::vector<std::byte> {
+    std::vector<std::byte> result;
+    for (auto chunk = reader.Next(); !chunk.empty(); chunk = reader.Next()) {
+        REQUIRE(chunk.size() <= ChunkSize);
+        result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+    REQUIRE(reader.Next().empty());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE ("Regular files are read through a mapping", "[io]") {
+    auto size = GENERATE(std::size_t {0}, std::size_t {1}, ChunkSize, 3 * ChunkSize, 3 * ChunkSize + 17);
+    auto data = randomBytes(size);
+
+    char path[] = "/tmp/kimp-io-XXXXXX";
+    int fd = ::mkstemp(path);
+    REQUIRE(fd >= 0);
+    REQUIRE(writeAll(fd, data));
+    ::close(fd);
+
+    {
+        auto reader = kimp::utils::openChunkReader(path, ChunkSize);
+        REQUIRE(reader->IsStable());
+        REQUIRE(readAll(*reader) == data);
+    }
+    ::unlink(path);
+}
+
+TEST_CASE ("Pipes are read through double buffers", "[io]") {
+
+    // A multiple of the chunk size ends with an empty buffer, the rest with a short tail
+    auto size = GENERATE(std::size_t {0}, std::size_t {17}, ChunkSize, 4 * ChunkSize, 4 * ChunkSize + 17);
+    auto data = randomBytes(size);
+
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    auto reader = kimp::utils::openChunkReader("/dev/fd/" + std::to_string(fds[0]), ChunkSize);
+    ::close(fds[0]);
+    REQUIRE_FALSE(reader->IsStable());
+
+    bool written {false};
+    std::thread writer ([&] () {
+        written = writeAll(fds[1], data);
+        ::close(fds[1]);
+    });
+    auto result = readAll(*reader);
+    writer.join();
+    REQUIRE(written);
+    REQUIRE(result == data);
+}
+
+TEST_CASE ("Missing input is reported", "[io]") {
+    REQUIRE_THROWS_AS(kimp::utils::openChunkReader("/nonexistent/kimp-io"), std::runtime_error);
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <utils/pipeline.hpp>
+#include <utils/queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+class TVectorReader : public kimp::utils::IChunkReader {
+public:
+    TVectorReader(const std::vector<std::byte>& data, std::size_t chunkSize)
+        : Data_{data}
+        , ChunkSize_{chunkSize}
+    {}
+
+    virtual auto Next() -> std::span<const std::byte> override {
+        // Previous chunk is overwritten to catch readers of stale spans
+        std::fill(Buffer_.begin(), Buffer_.end(), std::byte {0});
+
+        std::size_t size = std::min(ChunkSize_ - Offset_ % 7, Data_.size() - Offset_);
+        Buffer_.assign(Data_.begin() + Offset_, Data_.begin() + Offset_ + size);
+        Offset_ += size;
+        return Buffer_;
+    }
+
+private:
+    const std::vector<std::byte>& Data_;
+    const std::size_t ChunkSize_;
+    std::size_t Offset_ {0};
+    std::vector<std::byte> Buffer_;
+};
+
+auto readAll(int fd) -> std::vector<std::byte> {
+    std::vector<std::byte> result;
+    std::byte buffer[4096];
+    ::lseek(fd, 0, SEEK_SET);
+    for (ssize_t got; (got = ::read(fd, buffer, sizeof(buffer))) > 0;) {
+        result.insert(result.end(), buffer, buffer + got);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE ("Bounded queue passes every value exactly once", "[pipeline]") {
+    kimp::utils::TBoundedQueue<std::size_t> queue {8};
+    std::atomic<bool> cancel {false};
+    constexpr std::size_t count = 100000;
+
+    std::vector<std::size_t> seen (count, 0);
+    std::thread producer ([&] () {
+        for (std::size_t i {0}; i < count; i++) {
+            queue.Push(i, cancel);
+        }
+    });
+    for (std::size_t i {0}; i < count; i++) {
+        std::size_t v {0};
+        REQUIRE(queue.Pop(v, cancel));
+        seen[v]++;
+    }
+    producer.join();
+
+    REQUIRE(std::all_of(seen.begin(), seen.end(), [] (std::size_t c) { return c == 1; }));
+
+    std::size_t v {0};
+    REQUIRE(!queue.TryPop(v));
+}
+
+TEST_CASE ("Parallel pipeline keeps input order", "[pipeline]") {
+    std::mt19937 rng {42};
+    std::vector<std::byte> data (1 << 20);
+    for (auto& b : data) b = static_cast<std::byte>(rng());
+
+    auto transform = [] (std::span<const std::byte> in, std::span<std::byte> out) {
+        for (std::size_t i {0}; i < in.size(); i++) {
+            out[i] = in[i] ^ std::byte {0x5A};
+        }
+    };
+
+    std::vector<std::byte> expected (data.size());
+    transform(data, expected);
+
+    for (std::size_t threads : {1, 2, 3, 8}) {
+        FILE* file = std::tmpfile();
+        {
+            TVectorReader reader {data, 4096};
+            kimp::utils::TChunkWriter writer {::dup(fileno(file)), true};
+
+            kimp::utils::TChunkPipeline pipeline {transform, threads};
+            REQUIRE(pipeline.Run(reader, writer) == data.size());
+        }
+        REQUIRE(readAll(fileno(file)) == expected);
+        std::fclose(file);
+    }
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <math/operation.hpp>
+#include <math/polynomial.hpp>
+#include <math/set.hpp>
+#include <utils/stats.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kimp::utils::EStatsCounter;
+using kimp::utils::TStats;
+
+// Cases run in order, the first one sees statistics not yet enabled
+TEST_CASE ("Nothing is counted until enabled", "[stats]") {
+    auto sum = std::make_shared<kimp::math::TSumOperation<i64>>();
+    sum->Apply(1, 2);
+    REQUIRE(TStats::Get().GetCounter(EStatsCounter::OperationApply) == 0);
+    {
+        KIMP_STATS_SCOPE("ignored");
+    }
+    REQUIRE(TStats::Get().GetPhases().empty());
+}
+
+TEST_CASE ("Hot path counters", "[stats]") {
+    auto& stats = TStats::Get();
+    stats.Enable();
+    stats.Reset();
+
+    auto sum = std::make_shared<kimp::math::TSumOperation<i64>>();
+    for (i64 i {0}; i < 100; i++) {
+        sum->Apply(i, i);
+    }
+    REQUIRE(stats.GetCounter(EStatsCounter::OperationApply) == 100);
+
+    auto set = std::make_shared<kimp::math::TStaticSet<i64>>(std::vector<i64> {0, 1, 2});
+    REQUIRE(set->contains(1));
+    REQUIRE(stats.GetCounter(EStatsCounter::ContainsProbe) == 1);
+
+    // {0, 1, 2} isn't closed under +, the check runs Apply at least once
+    REQUIRE_FALSE(sum->IsClosedFor(set, kimp::math::EClosureCheck::Full));
+    REQUIRE(stats.GetCounter(EStatsCounter::ClosureCheck) == 1);
+    REQUIRE(stats.GetCounter(EStatsCounter::OperationApply) > 100);
+
+    kimp::math::TPolynomial<i64> small {1, 2, 3};
+    REQUIRE(stats.GetCounter(EStatsCounter::PolynomialAllocation) == 0);
+    kimp::math::TPolynomial<i64> large {std::vector<i64> (kimp::math::TPolynomial<i64>::InlineDegree + 2, 1)};
+    REQUIRE(stats.GetCounter(EStatsCounter::PolynomialAllocation) == 1);
+
+    std::vector<std::thread> threads;
+    for (int t {0}; t < 4; t++) {
+        threads.emplace_back([&] () {
+            for (i64 i {0}; i < 1000; i++) {
+                sum->Apply(i, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // Blocks of finished threads are reset as well
+    stats.Reset();
+    REQUIRE(stats.GetCounter(EStatsCounter::OperationApply) == 0);
+
+    threads.clear();
+    for (int t {0}; t < 4; t++) {
+        threads.emplace_back([&] () {
+            for (i64 i {0}; i < 1000; i++) {
+                sum->Apply(i, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(stats.GetCounter(EStatsCounter::OperationApply) == 4000);
+}
+
+TEST_CASE ("Phases and reports", "[stats]") {
+    auto& stats = TStats::Get();
+    stats.Enable();
+    stats.Reset();
+
+    for (int i {0}; i < 3; i++) {
+        KIMP_STATS_SCOPE("outer");
+        KIMP_STATS_SCOPE("inner");
+    }
+    std::thread {[] () { KIMP_STATS_SCOPE("worker"); }}.join();
+
+    auto phases = stats.GetPhases();
+    REQUIRE(phases.size() == 7);
+    // Scopes close in reverse, so inner goes first and fits into outer
+    REQUIRE(phases[0].Name == "inner");
+    REQUIRE(phases[1].Name == "outer");
+    REQUIRE(phases[0].Start >= phases[1].Start);
+    REQUIRE(phases[0].Start + phases[0].Duration <= phases[1].Start + phases[1].Duration);
+    REQUIRE(phases[6].Name == "worker");
+    REQUIRE(phases[6].Thread != phases[0].Thread);
+
+    auto table = stats.FormatTable();
+    REQUIRE(table.find("operation_apply") != std::string::npos);
+    REQUIRE(table.find("outer") != std::string::npos);
+
+    auto json = stats.FormatJson();
+    REQUIRE(json.starts_with("{\"counters\": {\"operation_apply\": "));
+    REQUIRE(json.find("\"inner\": {\"calls\": 3, ") != std::string::npos);
+
+    std::string path = "stats_trace_test.json";
+    stats.WriteChromeTrace(path);
+    std::ifstream file {path};
+    std::string trace {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+    std::remove(path.c_str());
+
+    REQUIRE(trace.starts_with("{\"traceEvents\": ["));
+    REQUIRE(trace.find("{\"name\": \"worker\", \"ph\": \"X\"") != std::string::npos);
+    REQUIRE(trace.find("\"ph\": \"C\"") != std::string::npos);
+    REQUIRE(trace.ends_with("]}\n"));
+
+    REQUIRE_THROWS(stats.WriteChromeTrace("/nonexistent/directory/trace.json"));
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <utils/table.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE ("Framed table rendering", "[table]") {
+    std::vector<std::string> labels {"0", "1", "x"};
+    std::ostringstream out;
+    kimp::utils::TTableRenderer {labels}.Render(out, [] (std::size_t row, std::size_t column) {
+        return (row + column) % 3;
+    });
+
+    REQUIRE(out.str() ==
+        "---------\n"
+        "| |0|1|x|\n"
+        "---------\n"
+        "|0|0|1|x|\n"
+        "---------\n"
+        "|1|1|x|0|\n"
+        "---------\n"
+        "|x|x|0|1|\n"
+        "---------\n"
+    );
+}
+
+TEST_CASE ("Large tables are flushed by parts", "[table]") {
+    std::vector<std::string> labels;
+    for (std::size_t i {0}; i < 300; i++) {
+        labels.push_back(std::to_string(i * 1000));
+    }
+    std::ostringstream out;
+    kimp::utils::TTableRenderer {labels}.Render(out, [] (std::size_t row, std::size_t column) {
+        return (row * column) % 300;
+    });
+
+    // Every label is padded to 6 symbols, there are 2 * 300 + 3 lines
+    std::size_t lineSize = 7 * 301 + 2;
+    REQUIRE(out.str().size() == lineSize * 603);
+    REQUIRE(out.str().substr(lineSize * 7, lineSize - 1).starts_with("|2000  |0     |2000  |4000  |"));
+}
+
+TEST_CASE ("CSV and binary tables", "[table]") {
+    std::vector<std::string> labels {"(0)", "(1, 0)", "say \"hi\""};
+    auto cell = [] (std::size_t row, std::size_t column) -> std::uint64_t {
+        return row * column % 3;
+    };
+
+    std::ostringstream csv;
+    kimp::utils::writeCsvTable(csv, labels, cell);
+    REQUIRE(csv.str() ==
+        ",(0),\"(1, 0)\",\"say \"\"hi\"\"\"\r\n"
+        "(0),(0),(0),(0)\r\n"
+        "\"(1, 0)\",(0),\"(1, 0)\",\"say \"\"hi\"\"\"\r\n"
+        "\"say \"\"hi\"\"\",(0),\"say \"\"hi\"\"\",\"(1, 0)\"\r\n"
+    );
+
+    std::ostringstream binary;
+    kimp::utils::writeBinaryTable(binary, labels.size(), cell);
+    auto bytes = binary.str();
+    REQUIRE(bytes.size() == 8 * 10);
+
+    auto read = [&] (std::size_t i) {
+        std::uint64_t v {0};
+        for (std::size_t k {8}; k-- > 0;) {
+            v = v << 8 | static_cast<unsigned char>(bytes[8 * i + k]);
+        }
+        return v;
+    };
+    REQUIRE(read(0) == 3);
+    for (std::size_t row {0}; row < 3; row++) {
+        for (std::size_t column {0}; column < 3; column++) {
+            REQUIRE(read(1 + 3 * row + column) == cell(row, column));
+        }
+    }
+}
+
+auto main(int argc, char ** argv) -> int {
+    return Catch::Session().run(argc, argv);
+}